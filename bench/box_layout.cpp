@@ -0,0 +1,181 @@
+//Compares BoxLayout inline item storage with the previous vector based storage
+//Build with -DIMRAD_BENCH=ON and run bin/bench_box_layout
+//Runs without a window, the ImGui context is only used for layout queries
+#include "imrad.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static size_t allocCount = 0;
+
+void* operator new(size_t size)
+{
+    ++allocCount;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+//BoxLayout before inline storage, only the parts used by generated code
+template <bool HORIZ>
+struct VectorBoxLayout
+{
+    static constexpr float ItemSize = 0;
+
+    struct Stretch {
+        float value;
+        Stretch(float v) : value(v) {}
+    };
+
+    void BeginLayout()
+    {
+        pos1 = HORIZ ? ImGui::GetCursorPosX() : ImGui::GetCursorPosY();
+        std::swap(prevItems, items);
+        items.clear();
+
+        float avail = HORIZ ? ImGui::GetContentRegionAvail().x : ImGui::GetContentRegionAvail().y;
+        float total = 0;
+        float stretchTotal = 0;
+        for (Item& it : prevItems) {
+            total += it.spacing;
+            if (it.stretch)
+                stretchTotal += it.size;
+            else if (it.size < 0) {
+                stretchTotal += 1.0;
+                total += -it.size;
+            }
+            else
+                total += it.size;
+        }
+        for (Item& it : prevItems) {
+            if (it.stretch)
+                it.size = (float)(int)(it.size * (avail - total) / stretchTotal);
+            else if (it.size < 0)
+                it.size = (float)(int)(1.0 * (avail - total) / stretchTotal);
+        }
+    }
+    void AddSize(int sp, float size)
+    {
+        float spacing = sp * (HORIZ ? ImGui::GetStyle().ItemSpacing.x : ImGui::GetStyle().ItemSpacing.y);
+        if (size == ItemSize)
+            size = HORIZ ? ImGui::GetItemRectSize().x : ImGui::GetItemRectSize().y;
+        items.push_back({ spacing, size, false });
+    }
+    void AddSize(int sp, Stretch size)
+    {
+        float spacing = sp * (HORIZ ? ImGui::GetStyle().ItemSpacing.x : ImGui::GetStyle().ItemSpacing.y);
+        items.push_back({ spacing, size.value, true });
+    }
+    float GetSize()
+    {
+        bool sameLine = !HORIZ && ImGui::GetCurrentWindow()->DC.IsSameLine;
+        size_t i = sameLine ? items.size() - 1 : items.size();
+        if (i >= prevItems.size())
+            return 0;
+        return prevItems[i].size;
+    }
+
+private:
+    struct Item {
+        float spacing;
+        float size;
+        bool stretch;
+    };
+    std::vector<Item> items, prevItems;
+    float pos1;
+};
+
+struct Result
+{
+    size_t warmupAllocs;
+    double nsPerFrame;
+    double allocsPerFrame;
+};
+
+//one frame lays out count items, every third one stretched
+//first frames are measured separately as they fill the buffers
+template <class Layout>
+Result Run(int count, int frames)
+{
+    using clock = std::chrono::steady_clock;
+    Layout layout;
+    float sink = 0;
+    size_t warmup = allocCount;
+    for (int f = 0; f < 10; ++f)
+    {
+        layout.BeginLayout();
+        for (int i = 0; i < count; ++i) {
+            sink += layout.GetSize();
+            if (i % 3)
+                layout.AddSize(1, 20.f);
+            else
+                layout.AddSize(1, typename Layout::Stretch(1.f));
+        }
+    }
+    warmup = allocCount - warmup;
+    size_t allocs = allocCount;
+    auto t0 = clock::now();
+    for (int f = 0; f < frames; ++f)
+    {
+        layout.BeginLayout();
+        for (int i = 0; i < count; ++i) {
+            sink += layout.GetSize();
+            if (i % 3)
+                layout.AddSize(1, 20.f);
+            else
+                layout.AddSize(1, typename Layout::Stretch(1.f));
+        }
+    }
+    auto t1 = clock::now();
+    if (sink < 0)
+        printf("%f", sink);
+    return {
+        warmup,
+        std::chrono::duration<double, std::nano>(t1 - t0).count() / frames,
+        double(allocCount - allocs) / frames
+    };
+}
+
+template <bool HORIZ>
+void Compare(const char* name, int count, int frames)
+{
+    Result vec = Run<VectorBoxLayout<HORIZ>>(count, frames);
+    Result box = Run<ImRad::BoxLayout<HORIZ>>(count, frames);
+    printf("%s %3d items: vector %8.1f ns/frame %5.2f allocs/frame %3d warmup allocs\n",
+        name, count, vec.nsPerFrame, vec.allocsPerFrame, (int)vec.warmupAllocs);
+    printf("%s %3d items: inline %8.1f ns/frame %5.2f allocs/frame %3d warmup allocs\n",
+        name, count, box.nsPerFrame, box.allocsPerFrame, (int)box.warmupAllocs);
+}
+
+int main()
+{
+    const int FRAMES = 10000;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = { 1280, 720 };
+    io.DeltaTime = 1.f / 60;
+    unsigned char* pixels;
+    int w, h;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &w, &h);
+
+    ImGui::NewFrame();
+    ImGui::SetNextWindowSize({ 800, 600 });
+    ImGui::Begin("bench");
+    Compare<true>("HBox", 4, FRAMES);
+    Compare<false>("VBox", 16, FRAMES);
+    Compare<false>("VBox", 50, FRAMES);
+    ImGui::End();
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    return 0;
+}
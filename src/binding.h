@@ -1,6 +1,10 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <unordered_set>
+#include <unordered_map>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <iomanip>
 #include <imgui.h>
@@ -148,6 +152,69 @@ private:
 
 //------------------------------------------------------------
 
+//immutable string interned in a process wide pool
+//it's pointer sized and equal strings share one copy so it is used for 
+//name tables which every widget instance carries
+class istr
+{
+public:
+    istr() : p(intern("")) {}
+    istr(std::string_view s) : p(intern(s)) {}
+    istr(const char* s) : p(intern(s)) {}
+    istr(const std::string& s) : p(intern(s)) {}
+    
+    const std::string& str() const { return *p; }
+    operator const std::string& () const { return *p; }
+    const char* c_str() const { return p->c_str(); }
+    bool empty() const { return p->empty(); }
+    bool operator== (std::string_view s) const { return *p == s; }
+    bool operator!= (std::string_view s) const { return *p != s; }
+    bool operator== (const char* s) const { return *p == s; }
+    bool operator!= (const char* s) const { return *p != s; }
+    bool operator== (const std::string& s) const { return *p == s; }
+    bool operator!= (const std::string& s) const { return *p != s; }
+    //pooled so comparing handles is enough
+    bool operator== (const istr& s) const { return p == s.p; }
+    bool operator!= (const istr& s) const { return p != s.p; }
+
+    struct hash {
+        size_t operator() (const istr& s) const { return std::hash<const void*>()(s.p); }
+    };
+
+    //lookup without interning, returns nullopt when s isn't pooled
+    //use it for read-only queries which would otherwise grow the pool
+    static std::optional<istr> find(std::string_view s) {
+        const auto& idx = pool();
+        auto it = idx.find(s);
+        if (it == idx.end())
+            return {};
+        return istr(it->second.get());
+    }
+
+private:
+    //keys view the owned strings so string_view lookups don't allocate
+    using pool_type = std::unordered_map<std::string_view, std::unique_ptr<const std::string>>;
+
+    explicit istr(const std::string* p) : p(p) {}
+
+    static pool_type& pool() {
+        static pool_type idx;
+        return idx;
+    }
+    //pooled strings are never freed so handles stay valid
+    static const std::string* intern(std::string_view s) {
+        auto& idx = pool();
+        auto it = idx.find(s);
+        if (it != idx.end())
+            return it->second.get();
+        auto str = std::make_unique<const std::string>(s);
+        const std::string* ps = str.get();
+        idx.emplace(*ps, std::move(str));
+        return ps;
+    }
+    const std::string* p;
+};
+
 template <class T>
 struct two_step
 {
@@ -174,6 +241,55 @@ struct property_base
     virtual void rename_variable(const std::string& oldn, const std::string& newn) = 0;
 };
 
+//symbol table of one document
+//identifiers are interned in a pool owned by the table so its memory goes
+//away with clear() and a reverse index maps them to the properties which use them
+class symbol_table
+{
+public:
+    //nullptr when the identifier isn't in the table
+    using id = const std::string*;
+
+    id find(std::string_view name) const {
+        auto it = pool.find(name);
+        return it != pool.end() ? it->second.get() : nullptr;
+    }
+    id intern(std::string_view name) {
+        auto it = pool.find(name);
+        if (it != pool.end())
+            return it->second.get();
+        auto str = std::make_unique<const std::string>(name);
+        id ps = str.get();
+        pool.emplace(*ps, std::move(str));
+        return ps;
+    }
+    void add_ref(std::string_view name, property_base* prop) {
+        auto& refs = index[intern(name)];
+        if (refs.empty() || refs.back() != prop)
+            refs.push_back(prop);
+    }
+    //properties which use name, nullptr when there are none
+    const std::vector<property_base*>* refs(std::string_view name) const {
+        auto it = index.find(find(name));
+        return it != index.end() ? &it->second : nullptr;
+    }
+    bool used(std::string_view name) const {
+        return refs(name) != nullptr;
+    }
+    bool empty() const {
+        return pool.empty();
+    }
+    void clear() {
+        index.clear();
+        pool.clear();
+    }
+
+private:
+    //keys view the owned strings so string_view lookups don't allocate
+    std::unordered_map<std::string_view, std::unique_ptr<const std::string>> pool;
+    std::unordered_map<id, std::vector<property_base*>> index;
+};
+
 //member variable expression like id, id.member, id[0], id.size()
 template <class T = void>
 struct field_ref : property_base
@@ -256,7 +372,7 @@ struct direct_val : property_base
     const std::string& get_id() const {
         static std::string none;
         auto it = stx::find_if(ids, [this](const auto& id) { return id.second == val; });
-        return it != ids.end() ? it->first : none;
+        return it != ids.end() ? it->first.str() : none;
     }
 
     operator T&() { return val; }
@@ -292,7 +408,7 @@ struct direct_val : property_base
     std::string to_arg(std::string_view = "", std::string_view = "") const {
         if (ids.size()) {
             auto it = stx::find_if(ids, [this](const auto& id) { return id.second == val; });
-            return it != ids.end() ? it->first : "";
+            return it != ids.end() ? it->first.str() : "";
         }
         else {
             std::ostringstream os;
@@ -310,7 +426,7 @@ struct direct_val : property_base
 
 private:
     T val;
-    std::vector<std::pair<std::string, T>> ids;
+    std::vector<std::pair<istr, T>> ids;
 };
 
 template <>
@@ -595,7 +711,7 @@ public:
         std::string str;
         for (const auto& id : ids)
             if ((f & id.second) && id.first != "")
-                str += pre + id.first + " | ";
+                str += pre + id.first.str() + " | ";
         if (str != "")
             str.resize(str.size() - 3);
         else
@@ -627,7 +743,7 @@ public:
     std::string get_name(int fl, bool prefixed = true) const {
         for (const auto& id : ids)
             if (id.second == fl && id.first != "") 
-                return prefixed ? pre + id.first : id.first;
+                return prefixed ? pre + id.first.str() : id.first.str();
         return "";
     }
     std::vector<std::string> used_variables() const { return {}; }
@@ -637,7 +753,7 @@ public:
 private:
     int f;
     std::string pre;
-    std::vector<std::pair<std::string, int>> ids;
+    std::vector<std::pair<istr, int>> ids;
 };
 
 //value or binding expression
@@ -909,9 +1025,14 @@ struct bindable<std::string> : property_base
                     auto id = cpp::find_id(s, k);
                     if (id == "")
                         break;
-                    if (id == oldn)
-                        str.replace(id.data() - str.data(), id.size(), newn);
+                    if (id == oldn) {
+                        s.replace(id.data() - s.data(), oldn.size(), newn);
+                        if (k != std::string::npos)
+                            k += newn.size() - oldn.size();
+                    }
                 }
+                str.replace(i, e - i, s);
+                i += s.size();
             }
         }
     }
@@ -997,9 +1118,14 @@ struct bindable<std::vector<std::string>> : property_base
                     auto id = cpp::find_id(s, k);
                     if (id == "")
                         break;
-                    if (id == oldn)
-                        str.replace(id.data() - str.data(), id.size(), newn);
+                    if (id == oldn) {
+                        s.replace(id.data() - s.data(), oldn.size(), newn);
+                        if (k != std::string::npos)
+                            k += newn.size() - oldn.size();
+                    }
                 }
+                str.replace(i, e - i, s);
+                i += s.size();
             }
         }
     };
@@ -1153,6 +1279,7 @@ struct data_loop : property_base
 {
     bindable<int> limit;
     field_ref<int> index; //int indexes are easier than size_t
+    direct_val<bool> virtualized = false; //iterate visible items only through ImGuiListClipper
 
     bool empty() const {
         return limit.empty();
@@ -1164,6 +1291,7 @@ struct data_loop : property_base
     void set_from_arg(std::string_view code) {
         if (code.compare(0, 4, "for("))
             return;
+        virtualized = code.find("=ImRad::ClipperBegin(") != std::string::npos;
         bool local = !code.compare(4, 3, "int") || !code.compare(4, 6, "size_t");
         auto i = code.find(";");
         if (i == std::string::npos)
@@ -1183,7 +1311,8 @@ struct data_loop : property_base
 
         limit.set_from_arg(code.substr(i + 1));
     }
-    std::string to_arg(std::string_view forVarName, std::string_view = "") const {
+    //itemHeight is used for virtualized loops, measured when empty
+    std::string to_arg(std::string_view forVarName, std::string_view itemHeight = "") const {
         if (empty())
             return "";
         std::ostringstream os;
@@ -1191,8 +1320,17 @@ struct data_loop : property_base
         os << "for (";
         if (index.empty())
             os << "int ";
-        os << name << " = 0; " << name << " < " << limit.to_arg()
-            << "; ++" << name << ")";
+        if (virtualized) {
+            os << name << " = ImRad::ClipperBegin(" << limit.to_arg();
+            if (itemHeight != "")
+                os << ", " << itemHeight;
+            os << "); " << name << " < " << limit.to_arg()
+                << "; " << name << " = ImRad::ClipperNext(" << name << "))";
+        }
+        else {
+            os << name << " = 0; " << name << " < " << limit.to_arg()
+                << "; ++" << name << ")";
+        }
         return os.str();
     }
     std::vector<std::string> used_variables() const {
@@ -11,14 +11,50 @@ namespace cpp
 {
     inline const std::string INVALID_TEXT = "???";
     
+    //character classes of the C locale, chars >= 128 have none
+    enum CharClass : unsigned char
+    {
+        CC_Space = 0x1,   //std::isspace
+        CC_Digit = 0x2,   //std::isdigit
+        CC_IdStart = 0x4, //std::isalpha or _
+        CC_Id = 0x8,      //std::isalnum or _
+        CC_Op = 0x10,     //single character punctuators recognized by the tokenizer
+    };
+
+    struct CharClassTable
+    {
+        unsigned char cls[256] = {};
+
+        constexpr CharClassTable()
+        {
+            for (int c : { ' ', '\t', '\n', '\v', '\f', '\r' })
+                cls[c] |= CC_Space;
+            for (int c = '0'; c <= '9'; ++c)
+                cls[c] |= CC_Digit | CC_Id;
+            for (int c = 'a'; c <= 'z'; ++c)
+                cls[c] |= CC_IdStart | CC_Id;
+            for (int c = 'A'; c <= 'Z'; ++c)
+                cls[c] |= CC_IdStart | CC_Id;
+            cls['_'] |= CC_IdStart | CC_Id;
+            for (char c : std::string_view("{}()[]<>;:.,?+-%*^&|~=!"))
+                cls[(unsigned char)c] |= CC_Op;
+        }
+        constexpr bool is(int c, CharClass cc) const {
+            return c >= 0 && c < 256 && (cls[c] & cc);
+        }
+        constexpr bool is(char c, CharClass cc) const {
+            return cls[(unsigned char)c] & cc;
+        }
+    };
+
+    inline constexpr CharClassTable CHAR_CLASS;
+
     inline bool is_id(std::string_view s)
     {
-        if (s.empty())
-            return false;
-        if (s[0] < 0 || (!std::isalpha(s[0]) && s[0] != '_'))
+        if (s.empty() || !CHAR_CLASS.is(s[0], CC_IdStart))
             return false;
         for (size_t i = 1; i < s.size(); ++i)
-            if (!std::isalnum(s[i]) && s[i] != '_')
+            if (!CHAR_CLASS.is(s[i], CC_Id))
                 return false;
         return true;
     }
@@ -80,7 +116,21 @@ namespace cpp
             //good for algorithms like replace_id
             while (in)
             {
-                int c = in->get();
+                //consume runs which need no checks in one go
+                if (line_mode)
+                    ;
+                else if (in_comment == 1 || in_pre)
+                    append_while([](int c) { return c != '\n'; });
+                else if (in_comment == 2)
+                    append_while([](int c) { return c != '*' && c != '/'; });
+                else if (in_string)
+                    append_while([](int c) { return c != '"' && c != '\n'; });
+                else if (tok.empty())
+                    skip_while([](int c) { return CHAR_CLASS.is(c, CC_Space); });
+                else if (tok.size() >= 2)
+                    append_while([](int c) { return CHAR_CLASS.is(c, CC_Id); });
+                
+                int c = get();
                 if (c == EOF)
                 {
                     if (tok != "")
@@ -93,18 +143,18 @@ namespace cpp
                     if (in_comment == 2)
                         tok += c;
                     else if (tok != "") {
-                        in->putback(c);
+                        putback(c);
                         break;
                     }
                     else if (line_mode) {
                         if (!first_n) { //ignore only first \n which was putback last time
-                            in->putback(c);
+                            putback(c);
                             break;
                         }
                         first_n = false;
                     }
                 }
-                else if (std::isspace(c))
+                else if (CHAR_CLASS.is(c, CC_Space))
                 {
                     if (line_mode) //receive verbatim
                         tok += c;
@@ -113,7 +163,7 @@ namespace cpp
                     else if (tok.empty()) //skip initial ws
                         continue;
                     else {
-                        in->putback(c);
+                        putback(c);
                         break;
                     }
                 }
@@ -122,7 +172,7 @@ namespace cpp
                     tok += c;
                     if (line_mode && 
                         tok.size() >= 3 && 
-                        std::all_of(tok.begin(), tok.end() - 3, [](char c){ return std::isspace(c); }) &&
+                        std::all_of(tok.begin(), tok.end() - 3, [](char c){ return CHAR_CLASS.is(c, CC_Space); }) &&
                         !tok.compare(tok.size() - 3, 3, "///"))
                     {
                         //hack - trim ws so our special comment will be recognized
@@ -151,7 +201,7 @@ namespace cpp
                         {
                             if (tok.size() >= 2) {
                                 tok.resize(tok.size() - 1);
-                                in->putback(c);
+                                putback(c);
                                 break;
                             }
                             in_string = true;
@@ -160,12 +210,12 @@ namespace cpp
                         {
                             if (tok.size() >= 2) {
                                 tok.resize(tok.size() - 1);
-                                in->putback(c);
+                                putback(c);
                                 break;
                             }
                             in_pre = true;
                         }
-                        else if (std::isdigit(c))
+                        else if (CHAR_CLASS.is(c, CC_Digit))
                         {
                             if (tok.size() == 1)
                                 in_num = true;
@@ -174,39 +224,34 @@ namespace cpp
                         {}
                         else if ((c == '+' || c == '-') &&
                             in_num &&
-                            tok.size() >= 2 && std::tolower(tok[tok.size() - 2]) == 'e')
+                            tok.size() >= 2 && (tok[tok.size() - 2] == 'e' || tok[tok.size() - 2] == 'E'))
                         {}
                         else if (c == '/')
                         {
-                            if (in->peek() != '/' && in->peek() != '*')
+                            if (peek() != '/' && peek() != '*')
                                 break;
                         }
-                        else if (c == '{' || c == '}' || c == '(' || c == ')' || 
-                            c == '[' || c == ']' || c == '<' || c == '>' ||
-                            c == ';' || c == ':' || c == '.' || c == ',' ||
-                            c == '?' || c == '+' || c == '-' || c == '%' ||
-                            c == '*' || c == '^' || c == '&' || c == '|' || 
-                            c == '~' || c == '=' || c == '!')
+                        else if (CHAR_CLASS.is(c, CC_Op))
                         {
                             if (tok.size() >= 2) { //output token before operator
                                 tok.resize(tok.size() - 1);
-                                in->putback(c);
+                                putback(c);
                                 break;
                             }
-                            if (c == '-' && std::isdigit(in->peek())) //unary -
+                            if (c == '-' && CHAR_CLASS.is(peek(), CC_Digit)) //unary -
                                 continue;
-                            if ((c == '<' && in->peek() == '<') ||
-                                (c == '<' && in->peek() == '=') ||
-                                (c == '>' && in->peek() == '>') ||
-                                (c == '>' && in->peek() == '=') ||
-                                (c == '=' && in->peek() == '=') ||
-                                (c == '!' && in->peek() == '=') ||
-                                (c == ':' && in->peek() == ':') ||
-                                (c == '-' && in->peek() == '>') ||
-                                (c == '&' && in->peek() == '&') ||
-                                (c == '|' && in->peek() == '|'))
+                            if ((c == '<' && peek() == '<') ||
+                                (c == '<' && peek() == '=') ||
+                                (c == '>' && peek() == '>') ||
+                                (c == '>' && peek() == '=') ||
+                                (c == '=' && peek() == '=') ||
+                                (c == '!' && peek() == '=') ||
+                                (c == ':' && peek() == ':') ||
+                                (c == '-' && peek() == '>') ||
+                                (c == '&' && peek() == '&') ||
+                                (c == '|' && peek() == '|'))
                             {
-                                tok += in->get();
+                                tok += get();
                             }
                             break;
                         }
@@ -219,6 +264,53 @@ namespace cpp
         }
 
     private:
+        //get/peek/putback talking to the streambuf directly. Stream state is 
+        //updated the same way as by the istream members (minus gcount) so 
+        //tellg and eof checks done by the callers are unaffected
+        int get() {
+            if (!in->good()) {
+                in->setstate(std::ios::failbit);
+                return EOF;
+            }
+            int c = in->rdbuf()->sbumpc();
+            if (c == EOF)
+                in->setstate(std::ios::eofbit | std::ios::failbit);
+            return c;
+        }
+        int peek() {
+            if (!in->good()) {
+                in->setstate(std::ios::failbit);
+                return EOF;
+            }
+            int c = in->rdbuf()->sgetc();
+            if (c == EOF)
+                in->setstate(std::ios::eofbit);
+            return c;
+        }
+        void putback(int c) {
+            in->clear(in->rdstate() & ~std::ios::eofbit);
+            if (!in->good())
+                in->setstate(std::ios::failbit);
+            else if (in->rdbuf()->sputbackc((char)c) == EOF)
+                in->setstate(std::ios::badbit);
+        }
+        template <class F>
+        void append_while(F pred) {
+            if (!in->good())
+                return;
+            auto* buf = in->rdbuf();
+            for (int c = buf->sgetc(); c != EOF && pred(c); c = buf->snextc())
+                tok += (char)c;
+        }
+        template <class F>
+        void skip_while(F pred) {
+            if (!in->good())
+                return;
+            auto* buf = in->rdbuf();
+            for (int c = buf->sgetc(); c != EOF && pred(c); c = buf->snextc())
+                ;
+        }
+
         std::istream* in;
         std::string tok;
         bool eof;
@@ -525,72 +617,204 @@ namespace cpp
             !s.compare(0, 10, "std::span<");
     }
 
-    //replaces identifier but ignores strings, preprocessor
-    inline void replace_id(std::string& code, std::string_view old, std::string news)
+    //token produced by scan_token
+    struct token_span
+    {
+        std::string_view text; //empty for comments
+        size_t end = 0;        //position after the token
+        size_t size = 0;       //size of the equivalent token_iterator token
+    };
+
+    //reads the same tokens as token_iterator (without line_mode) but directly 
+    //from a string so it's cheap enough for short expressions evaluated every frame.
+    //Returns false at the end of input, otherwise the token is in tok and i moves past it
+    inline bool scan_token(std::string_view s, size_t& i, token_span& tok)
+    {
+        int in_comment = 0; //1 - //, 2 - /*
+        bool in_string = false;
+        bool in_pre = false;
+        bool in_num = false;
+        size_t p = i;
+        size_t b = p;
+        size_t len = 0;
+        auto peek = [&] { return p < s.size() ? (int)(unsigned char)s[p] : EOF; };
+        while (true)
+        {
+            if (p >= s.size())
+            {
+                if (len)
+                    break;
+                i = p;
+                return false;
+            }
+            char c = s[p++];
+            if (c == '\n')
+            {
+                if (in_comment == 2)
+                    ++len;
+                else if (len) {
+                    --p;
+                    break;
+                }
+            }
+            else if (CHAR_CLASS.is(c, CC_Space))
+            {
+                if (in_comment || in_string || in_pre)
+                    ++len;
+                else if (len) {
+                    --p;
+                    break;
+                }
+            }
+            else
+            {
+                if (!len)
+                    b = p - 1;
+                ++len;
+                if (in_comment == 2 && len >= 2 && s[p - 2] == '*' && c == '/')
+                {
+                    len -= 2;
+                    break;
+                }
+                else if (in_string && c == '"')
+                {
+                    break;
+                }
+                else if (!in_comment && !in_string && !in_pre)
+                {
+                    if (len >= 2 && s[b] == '/' && s[b + 1] == '/') {
+                        len = 0;
+                        in_comment = 1;
+                    }
+                    else if (len >= 2 && s[b] == '/' && s[b + 1] == '*') {
+                        len = 0;
+                        in_comment = 2;
+                    }
+                    else if (c == '"')
+                    {
+                        if (len >= 2) {
+                            --len;
+                            --p;
+                            break;
+                        }
+                        in_string = true;
+                    }
+                    else if (c == '#')
+                    {
+                        if (len >= 2) {
+                            --len;
+                            --p;
+                            break;
+                        }
+                        in_pre = true;
+                    }
+                    else if (CHAR_CLASS.is(c, CC_Digit))
+                    {
+                        if (len == 1)
+                            in_num = true;
+                    }
+                    else if (c == '.' && in_num)
+                    {}
+                    else if ((c == '+' || c == '-') &&
+                        in_num &&
+                        len >= 2 && (s[p - 2] == 'e' || s[p - 2] == 'E'))
+                    {}
+                    else if (c == '/')
+                    {
+                        if (peek() != '/' && peek() != '*')
+                            break;
+                    }
+                    else if (CHAR_CLASS.is(c, CC_Op))
+                    {
+                        if (len >= 2) { //output token before operator
+                            --len;
+                            --p;
+                            break;
+                        }
+                        int n = peek();
+                        if (c == '-' && CHAR_CLASS.is(n, CC_Digit)) //unary -
+                            continue;
+                        if ((c == '<' && n == '<') ||
+                            (c == '<' && n == '=') ||
+                            (c == '>' && n == '>') ||
+                            (c == '>' && n == '=') ||
+                            (c == '=' && n == '=') ||
+                            (c == '!' && n == '=') ||
+                            (c == ':' && n == ':') ||
+                            (c == '-' && n == '>') ||
+                            (c == '&' && n == '&') ||
+                            (c == '|' && n == '|'))
+                        {
+                            ++p;
+                            ++len;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+        i = p;
+        tok.end = p;
+        tok.size = in_comment ? len + 2 : len;
+        tok.text = in_comment ? std::string_view() : s.substr(b, len);
+        return true;
+    }
+
+    //replaces identifier but ignores strings, preprocessor, comments
+    inline void replace_id(std::string& code, std::string_view old, std::string_view news)
     {
-        std::istringstream in(code);
-        std::streampos pos = 0;
         std::string out;
-        std::string buf;
-        for (token_iterator iter(in); iter != token_iterator(); ++iter)
+        size_t pos = 0;
+        size_t i = 0;
+        token_span tok;
+        while (scan_token(code, i, tok))
         {
-            if (*iter != old)
+            if (tok.text != old)
                 continue;
-            //relies on token_iterator doing putback
-            auto n = in.tellg() - pos;
-            in.seekg(pos);
-            buf.resize(n - old.size());
-            in.read(buf.data(), buf.size());
-            out += buf;
-            in.ignore(old.size());
+            out.append(code, pos, tok.end - old.size() - pos);
             out += news;
-            pos += n;
-        }
-        in.clear(); //clear EOF flag
-        in.seekg(0, std::ios::end);
-        auto n = in.tellg() - pos;
-        in.seekg(pos);
-        buf.resize(n);
-        in.read(buf.data(), n);
-        out += buf;
-        
-        code = out;
+            pos = tok.end;
+        }
+        if (!pos)
+            return;
+        out.append(code, pos);
+        code = std::move(out);
     }
 
     //ImGui::GetStyle().Colors[alignment==0 ? ImGuiCol_X : ImGuiCol_Y] --> alignment, ImGuiCol_X, ImGuiCol_Y
-    inline std::string_view find_id(const std::string& expr, size_t& i)
+    inline std::string_view find_id(std::string_view expr, size_t& i)
     {
-        std::istringstream in(expr);
-        in.seekg(i);
         std::string_view id;
         bool ignore_ids = false;
-        for (token_iterator it(in); it != token_iterator(); ++it)
+        size_t p = i;
+        token_span tok;
+        if (p > expr.size())
+            p = expr.size();
+        while (scan_token(expr, p, tok))
         {
-            if (is_id(*it) || *it == "::") {
+            if (is_id(tok.text) || tok.text == "::") {
                 if (ignore_ids)
                     ;
                 else if (id != "") //append
-                    id = std::string_view(expr).substr(id.data() - expr.data(), expr.data() + in.tellg() - id.data());
-                else {
-                    size_t pos = !in ? expr.size() : (size_t)in.tellg();
-                    id = std::string_view(expr).substr(pos - it->size(), it->size());
-                }
+                    id = expr.substr(id.data() - expr.data(), tok.end - (id.data() - expr.data()));
+                else
+                    id = tok.text;
             }
-            else if (*it == "." || *it == "->") {
+            else if (tok.text == "." || tok.text == "->") {
                 ignore_ids = true;
                 if (id != "") {
-                    i = (size_t)in.tellg() - it->size();
+                    i = tok.end - tok.size;
                     return id;
                 }
             }
-            else if (id != "" && *it == "(") { //function call
+            else if (id != "" && tok.text == "(") { //function call
                 id = "";
                 ignore_ids = false;
             }
             else {
                 ignore_ids = false;
                 if (id != "") {
-                    i = (size_t)in.tellg() - it->size();
+                    i = tok.end - tok.size;
                     return id;
                 }
             }
@@ -693,9 +917,15 @@ namespace cpp
         {
             return unescape(str.substr(1, str.size() - 2), true);
         }
-        else if (!str.compare(0, 15, "ImRad::Format(\"") &&
-                !str.compare(str.size() - 9, 9, ").c_str()")) 
+        else if ((!str.compare(0, 15, "ImRad::Format(\"") &&
+                  !str.compare(str.size() - 9, 9, ").c_str()")) ||
+                 (!str.compare(0, 20, "ImRad::FrameFormat(\"") && str.back() == ')') ||
+                 (!str.compare(0, 33, "ImRad::FrameFormat(IMRAD_FORMAT(\"") && str.back() == ')'))
         {
+            //older code used Format(...).c_str() or FrameFormat without IMRAD_FORMAT
+            bool wrapped = !str.compare(0, 33, "ImRad::FrameFormat(IMRAD_FORMAT(\"");
+            size_t prefix = wrapped ? 33 : str[7] == 'F' && str[8] == 'r' ? 20 : 15;
+            size_t suffix = prefix == 15 ? 9 : 1;
             auto find_curly = [](std::string_view s, size_t i) {
                 --i;
                 while (true) {
@@ -708,10 +938,12 @@ namespace cpp
                 }
                 return std::string::npos;
             };
-            std::istringstream is((std::string)str.substr(15 - 1, str.size() - 9 - 15 + 1));
+            std::istringstream is((std::string)str.substr(prefix - 1, str.size() - suffix - prefix + 1));
             token_iterator it(is);
             std::string format = *it++;
             format = format.substr(1, format.size() - 2);
+            if (wrapped && *it == ")")
+                ++it;
             std::string expr, str;
             size_t i = 0;
             int level = 0;
@@ -856,7 +1088,7 @@ namespace cpp
 error:
         if (args.empty())
             return "\"" + lit + "\"";
-        return "ImRad::Format(\"" + fmt + "\"" + args + ").c_str()";
+        return "ImRad::FrameFormat(IMRAD_FORMAT(\"" + fmt + "\")" + args + ")";
     }
 
     //1. limits length of lengthy {} expression (like in case it contains ?:)
@@ -12,10 +12,22 @@ const std::string SPEC_FUN[] = {
     "Open", "Close", "OpenPopup", "ClosePopup", "ResetLayout", "Init", "Draw",
 };
 
+//optional parts of the runtime and identifiers which need them
+const std::pair<std::string, std::vector<std::string>> RUNTIME_HEADERS[] = {
+    { "imrad_animator.h", { "ImRad::Animator", "ImRad::BasicAnimator", "ImRad::Ease" } },
+    { "imrad_format.h", { "ImRad::Format", "ImRad::FrameFormat", "ImRad::FrameString", "ImRad::LabelCache" } },
+    { "imrad_texture.h", { "ImRad::LoadTexture", "ImRad::CreateTexture", "ImRad::LoadImageData" } },
+    { "imrad_style.h", { "ImRad::LoadStyle", "ImRad::LoadStyleCache", "ImRad::SaveStyle", "ImRad::CompileStyle" } },
+};
+
 const std::string_view CppGen::INDENT = "    ";
 const std::string_view CppGen::FOR_VAR_NAME = "i";
 const std::string_view CppGen::HBOX_NAME = "hb";
 const std::string_view CppGen::VBOX_NAME = "vb";
+const std::string_view CppGen::LABEL_CACHE_NAME = "lc";
+const std::string_view CppGen::ROW_HEIGHTS_NAME = "rh";
+const std::string_view CppGen::COMBO_INDEX_NAME = "ci";
+const std::string_view CppGen::FONT_HANDLE_NAME = "fh";
 
 CppGen::CppGen()
     : m_name("Untitled"), m_vname("untitled")
@@ -51,6 +63,20 @@ std::string CppGen::AltFName(const std::string& path)
     return "";
 }
 
+//Draw and cached layout state go here when splitDraw is set
+std::string CppGen::DrawFName(const std::string& path)
+{
+    fs::path p(path);
+    return p.replace_extension(".draw.cpp").string();
+}
+
+static void ReadLines(std::istream& fin, std::ostream& out)
+{
+    std::string line;
+    while (std::getline(fin, line))
+        out << line << "\n";
+}
+
 bool CppGen::ExportUpdate(
     const std::string& fname, 
     TopWindow* node, 
@@ -68,6 +94,68 @@ bool CppGen::ExportUpdate(
     m_vname = (char)std::tolower(m_name[0]) + m_name.substr(1);
     */
 
+    auto hpath = fs::path(fname).replace_extension(".h");
+    auto fpath = fs::path(fname).replace_extension(".cpp");
+    std::stringstream hprev, fprev;
+    std::ifstream fin(hpath);
+    ReadLines(fin, hprev);
+    fin.close();
+    fin.open(fpath);
+    ReadLines(fin, fprev);
+    fin.close();
+    
+    std::ostringstream hout, fout, dout;
+    if (!ExportUpdate(hpath.filename().string(), hprev, hout, fprev, fout, node, params, err, &dout))
+        return false;
+
+    std::ofstream fwrite(hpath, std::ios::trunc);
+    if (!(fwrite << hout.str())) {
+        err = "can't write to '" + hpath.string() + "'";
+        return false;
+    }
+    fwrite.close();
+    fwrite.open(fpath, std::ios::trunc);
+    if (!(fwrite << fout.str())) {
+        err = "can't write to '" + fpath.string() + "'";
+        return false;
+    }
+    fwrite.close();
+    auto dpath = fs::path(DrawFName(fname));
+    if (m_splitDraw) {
+        fwrite.open(dpath, std::ios::trunc);
+        if (!(fwrite << dout.str())) {
+            err = "can't write to '" + dpath.string() + "'";
+            return false;
+        }
+    }
+    else {
+        //Draw went back to .cpp
+        std::error_code ec;
+        fs::remove(dpath, ec);
+    }
+    return true;
+}
+
+//in-memory version used by ExportUpdate and the --roundtrip check
+//empty hprev/fprev will be initialized with a new stub
+//dout receives the generated .draw.cpp when splitDraw is set
+bool CppGen::ExportUpdate(
+    const std::string& hname,
+    std::istream& hprev, std::ostream& hout,
+    std::istream& fprev, std::ostream& fout,
+    TopWindow* node,
+    const std::map<std::string, std::string>& params,
+    std::string& err,
+    std::ostream* dout
+)
+{
+    auto sit = params.find("splitDraw");
+    m_splitDraw = sit != params.end() && sit->second == "true";
+    if (m_splitDraw && !dout) {
+        err = "no output for the draw file";
+        return false;
+    }
+
     //export node before ExportH
     //TopWindow::Export generates some variables on the fly
     UIContext ctx;
@@ -81,49 +169,38 @@ bool CppGen::ExportUpdate(
     for (const std::string& e : ctx.errors)
         err += e + "\n";
 
+    //user functions in .cpp may use optional headers as well
+    std::string headerScan = code.str();
+    headerScan.append(std::istreambuf_iterator<char>(fprev), {});
+    fprev.clear();
+    fprev.seekg(0);
+    auto headers = GetRuntimeHeaders(node, headerScan);
+
     //export .h
-    auto hpath = fs::path(fname).replace_extension(".h");
-    if (!fs::exists(hpath) || fs::is_empty(hpath))
+    std::stringstream stub;
+    std::istream* prev = &hprev;
+    if (hprev.peek() == std::char_traits<char>::eof())
     {
-        std::ofstream fout(hpath);
-        if (!fout) {
-            err = "can't write to '" + hpath.string() + "'";
-            return false;
-        }
-        CreateH(fout);
+        CreateH(stub);
+        prev = &stub;
     }
-    std::ifstream fin(hpath);
-    std::string line;
-    std::stringstream fprev;
-    while (std::getline(fin, line))
-        fprev << line << "\n";
-    fin.close();
-    fprev.seekg(0);
-    std::ofstream fout(hpath, std::ios::trunc);
-    auto origNames = ExportH(fout, fprev, m_hname, node);
-    m_hname = hpath.filename().string();
-    fout.close();
+    auto origNames = ExportH(hout, *prev, m_hname, node, headers);
+    m_hname = hname;
     
     //export .cpp
-    auto fpath = fs::path(fname).replace_extension(".cpp");
-    if (!fs::exists(fpath) || fs::is_empty(fpath))
+    stub.str("");
+    stub.clear();
+    prev = &fprev;
+    if (fprev.peek() == std::char_traits<char>::eof())
     {
-        std::ofstream fout(fpath);
-        if (!fout) {
-            err = "can't write to '" + hpath.string() + "'";
-            return false;
-        }
-        CreateCpp(fout);
+        CreateCpp(stub);
+        prev = &stub;
     }
-    fin.open(fpath);
-    fprev.str("");
-    fprev.clear();
-    while (std::getline(fin, line))
-        fprev << line << "\n";
-    fin.close();
-    fprev.seekg(0);
-    fout.open(fpath, std::ios::trunc);
-    ExportCpp(fout, fprev, origNames, params, node, code.str());
+    ExportCpp(fout, *prev, origNames, params, node, code.str());
+
+    //export .draw.cpp
+    if (m_splitDraw)
+        ExportDraw(*dout, params, node, code.str());
     return true;
 }
 
@@ -165,7 +242,8 @@ CppGen::ExportH(
     std::ostream& fout, 
     std::istream& fprev, 
     const std::string& origHName, 
-    TopWindow* node
+    TopWindow* node,
+    const std::vector<std::string>& headers
 )
 {
     int level = 0;
@@ -179,6 +257,10 @@ CppGen::ExportH(
     std::string origName, origVName;
     std::stringstream out;
     bool hasLayout = GetLayoutVars().size();
+    //optional headers are only added, user may include them elsewhere
+    std::string prevText(std::istreambuf_iterator<char>(fprev), {});
+    fprev.clear();
+    fprev.seekg(0);
 
     //xpos == 0 => copy until current position
     //xpos > 0 => copy until xpos
@@ -302,7 +384,7 @@ CppGen::ExportH(
                 
                 //write special members
                 bool found = false;
-                if (hasLayout)
+                if (hasLayout || m_splitDraw)
                 {
                     found = true; 
                     out << INDENT << "void ResetLayout();\n";
@@ -361,12 +443,21 @@ CppGen::ExportH(
                 {
                     out << INDENT << "bool isOpen = true;\n";
                 }
+                if (m_splitDraw)
+                {
+                    //layout state is defined in .draw.cpp so that it can change
+                    //without touching this header
+                    out << INDENT << "struct DrawCache;\n";
+                    out << INDENT << "std::shared_ptr<DrawCache> drawCache;\n";
+                }
                 
                 //other fields
                 for (const auto& var : m_fields[""])
                 {
                     if ((var.flags & Var::UserCode) || !(var.flags & Var::Impl))
                         continue;
+                    if (m_splitDraw && IsDrawCacheVar(var))
+                        continue;
                     if (var.type.size() < 5 || var.type.compare(0, 5, "void(")) 
                     {
                         out << INDENT << var.type << " " << var.name;
@@ -443,6 +534,14 @@ CppGen::ExportH(
         }
         else if (!tok.compare(0, 1, "#")) {
             preamble = false;
+            if (!tok.compare(0, 18, "#include \"imrad.h\"")) {
+                copy_content();
+                for (const std::string& h : headers) {
+                    std::string inc = "#include \"" + h + "\"";
+                    if (prevText.find(inc) == std::string::npos)
+                        out << "\n" << inc;
+                }
+            }
         }
         else if (tok == ";") {
             if (line.size() == 3 && line[0] == "extern" && line[1] == origName) {
@@ -490,6 +589,9 @@ CppGen::ExportCpp(
     std::streampos fpos = 0;
     std::set<std::string> funs;
     auto animPos = node->animate ? (TopWindow::Placement)node->placement : TopWindow::None;
+    //buffered because removed functions are cut by seeking back which can leave
+    //stale text behind when nothing long enough is written after them
+    std::stringstream out;
 
     //xpos == 0 => copy until current position
     //xpos > 0 => copy until xpos
@@ -501,7 +603,7 @@ CppGen::ExportCpp(
         fprev.seekg(fpos);
         buf.resize(pos - fpos - ignore_last);
         fprev.read(buf.data(), buf.size());
-        fout.write(buf.data(), buf.size());
+        out.write(buf.data(), buf.size());
         fprev.ignore(ignore_last);
         fpos = pos;
     };
@@ -516,12 +618,12 @@ CppGen::ExportCpp(
                 !tok.compare(10, origNames[2].size(), origNames[2]))
             {
                 copy_content(-(int)tok.size());
-                fout << "#include \"" << m_hname << "\"";
+                out << "#include \"" << m_hname << "\"";
             }
             else if (!tok.compare(0, 2, "//")) {
                 if (preamble && tok.find(GENERATED_WITH) != std::string::npos) {
                     copy_content(-(int)tok.size());
-                    fout << "// " << GENERATED_WITH << VER_STR;
+                    out << "// " << GENERATED_WITH << VER_STR;
                 }
             }
             else if (!tok.compare(0, 1, "#")) {
@@ -544,23 +646,29 @@ CppGen::ExportCpp(
                     else {
                         //remove member which is no longer needed
                         //Init contains user code so we don't want to delete it completely
-                        fout.seekp((int)fout.tellp() - 5 - m_name.size());
+                        out.seekp((int)out.tellp() - 5 - m_name.size());
                         comment_to_level = level - 1;
                         fpos = fprev.tellg();
-                        fout << "/* void " << m_name << "::" << name << "() REMOVED\n{";
+                        out << "/* void " << m_name << "::" << name << "() REMOVED\n{";
                     }
                 }
+                else if (InDrawFile(name))
+                {
+                    //moved to .draw.cpp
+                    out.seekp((int)out.tellp() - 5 - m_name.size());
+                    skip_to_level = level - 1;
+                }
                 else if (stx::count(SPEC_FUN, name)) 
                 {
-                    if (WriteStub(fout, name, node->kind, animPos, params, code)) {
+                    if (WriteStub(out, name, node->kind, animPos, params, code)) {
                         funs.insert(name);
                         skip_to_level = level - 1;
                     }
                     else {
                         //remove member which is no longer needed
-                        fout.seekp((int)fout.tellp() - 5 - m_name.size());
+                        out.seekp((int)out.tellp() - 5 - m_name.size());
                         skip_to_level = level - 1;
-                        fout << "// void " << m_name << "::" << name << " REMOVED";
+                        out << "// void " << m_name << "::" << name << " REMOVED";
                     }
                 }
                 else if (name != "")
@@ -576,17 +684,17 @@ CppGen::ExportCpp(
                 //replace old names & move cursor past consistently
                 if (tok == m_name) {
                     copy_content(-(int)tok.size());
-                    fout << m_name;
+                    out << m_name;
                 }
                 else if (tok == origNames[0]) {
                     tok = m_name;
                     copy_content(-(int)origNames[0].size());
-                    fout << m_name;
+                    out << m_name;
                 }
                 else if (tok == origNames[1]) {
                     tok = m_vname;
                     copy_content(-(int)origNames[1].size());
-                    fout << m_vname;
+                    out << m_vname;
                 }
                 preamble = false;
                 line.push_back(tok);
@@ -604,7 +712,7 @@ CppGen::ExportCpp(
             if (comment_to_level == level) {
                 comment_to_level = -1;
                 copy_content();
-                fout << "*/";
+                out << "*/";
             }
         }
     }
@@ -617,12 +725,12 @@ CppGen::ExportCpp(
     //add missing members
     for (const auto& name : SPEC_FUN)
     {
-        if (funs.count(name))
+        if (funs.count(name) || InDrawFile(name))
             continue;
         std::ostringstream os;
         if (WriteStub(os, name, node->kind, animPos, params, code)) {
             funs.insert(name);
-            fout << "\nvoid " << m_name << os.str() << "\n";
+            out << "\nvoid " << m_name << os.str() << "\n";
         }
     }
 
@@ -635,12 +743,122 @@ CppGen::ExportCpp(
             continue;
         if (funs.count(var.name) || stx::count(SPEC_FUN, var.name))
             continue;
-        fout << "\nvoid " << m_name << "::" << var.name << "(";
+        out << "\nvoid " << m_name << "::" << var.name << "(";
         std::string arg = var.type.substr(5, var.type.size() - 6);
         if (arg.size())
-            fout << "const " << arg << "& args";
-        fout << ")\n{\n}\n";
+            out << "const " << arg << "& args";
+        out << ")\n{\n}\n";
     }
+
+    //flush
+    fout << out.str().substr(0, (size_t)out.tellp());
+}
+
+//.draw.cpp is regenerated completely on each export
+void CppGen::ExportDraw(
+    std::ostream& fout,
+    const std::map<std::string, std::string>& params,
+    TopWindow* node,
+    const std::string& code
+)
+{
+    fout << "// " << GENERATED_WITH << VER_STR << "\n"
+        << "// visit " << GITHUB_URL << "\n\n";
+
+    fout << "#include \"" << m_hname << "\"\n\n";
+
+    std::vector<const Var*> vars;
+    for (const auto& var : m_fields[""])
+        if (!(var.flags & Var::UserCode) && IsDrawCacheVar(var))
+            vars.push_back(&var);
+
+    fout << "struct " << m_name << "::DrawCache\n{\n";
+    for (const Var* var : vars)
+    {
+        fout << INDENT << var->type << " " << var->name;
+        if (var->init != "")
+            fout << " = " << var->init;
+        fout << ";\n";
+    }
+    fout << "};\n";
+
+    fout << "\nvoid " << m_name << "::ResetLayout()\n{\n";
+    fout << INDENT << "if (!drawCache)\n";
+    fout << INDENT << INDENT << "return;\n";
+    for (const std::string& var : GetLayoutVars())
+        fout << INDENT << "drawCache->" << var << ".Reset();\n";
+    fout << "}\n";
+
+    //bind cache members under their usual names so the generated code stays the same
+    std::ostringstream bind;
+    if (vars.size()) {
+        bind << INDENT << "if (!drawCache)\n";
+        bind << INDENT << INDENT << "drawCache = std::make_shared<DrawCache>();\n";
+        for (const Var* var : vars)
+            bind << INDENT << "auto& " << var->name << " = drawCache->" << var->name << ";\n";
+    }
+    std::string dcode = code;
+    const std::string BEGIN = "/// @begin TopWindow\n";
+    size_t i = dcode.find(BEGIN);
+    if (i != std::string::npos)
+        dcode.insert(i + BEGIN.size(), bind.str());
+
+    std::ostringstream os;
+    WriteStub(os, "Draw", node->kind, TopWindow::Placement::None, params, dcode);
+    fout << "\nvoid " << m_name << os.str() << "\n";
+}
+
+//generated members are named prefix + number and have a known type
+//so user fields called like rh or lc2 are never taken for them
+bool IsPrefixedVar(const CppGen::Var& var, std::string_view prefix, std::string_view type)
+{
+    return !(var.flags & CppGen::Var::UserCode) &&
+        var.type == type &&
+        var.name.size() > prefix.size() &&
+        !var.name.compare(0, prefix.size(), prefix) &&
+        var.name.find_first_not_of("0123456789", prefix.size()) == std::string::npos;
+}
+
+bool CppGen::IsDrawCacheVar(const Var& var) const
+{
+    const std::pair<std::string_view, std::string_view> CACHE_VARS[] = {
+        { HBOX_NAME, "ImRad::HBox" },
+        { VBOX_NAME, "ImRad::VBox" },
+        { LABEL_CACHE_NAME, "ImRad::LabelCache" },
+        { ROW_HEIGHTS_NAME, "ImRad::RowHeights" },
+        { COMBO_INDEX_NAME, "ImRad::ComboIndex" },
+        { FONT_HANDLE_NAME, "ImRad::FontHandle" },
+    };
+    for (const auto& cv : CACHE_VARS)
+    {
+        if (IsPrefixedVar(var, cv.first, cv.second))
+            return true;
+    }
+    return false;
+}
+
+std::vector<std::string> CppGen::GetRuntimeHeaders(TopWindow* node, const std::string& code)
+{
+    std::string text = code;
+    for (const auto& scope : m_fields)
+        for (const auto& var : scope.second)
+            text += var.type + " " + var.init + "\n";
+    //animator field is written by ExportH
+    if (node->animate)
+        text += "ImRad::Animator";
+
+    std::vector<std::string> headers;
+    for (const auto& rh : RUNTIME_HEADERS)
+    {
+        if (stx::count_if(rh.second, [&](const std::string& id) { return text.find(id) != std::string::npos; }))
+            headers.push_back(rh.first);
+    }
+    return headers;
+}
+
+bool CppGen::InDrawFile(const std::string& id) const
+{
+    return m_splitDraw && (id == "Draw" || id == "ResetLayout");
 }
 
 std::vector<std::string> CppGen::GetLayoutVars()
@@ -825,6 +1043,15 @@ CppGen::Import(
         if (!node)
             node = std::move(node2);
     }
+    fin.close();
+
+    fpath = DrawFName(path);
+    fin.open(fpath.string());
+    if (fin) {
+        auto node2 = ImportCode(fin, fpath.filename().string(), params);
+        if (!node)
+            node = std::move(node2);
+    }
     
     if (m_name == "")
         m_error += "No window class found!\n";
@@ -1025,7 +1252,8 @@ bool CppGen::ParseFieldDecl(const std::string& sname, const std::vector<std::str
                     type.pop_back();
             }
             if (name != "ID" && name != "modalResult" && name != "callback" &&
-                name != "isOpen" && name != "animator" && name != "animPos")
+                name != "isOpen" && name != "animator" && name != "animPos" &&
+                name != "drawCache")
             {
                 CreateNamedVar(name, type, init, flags, sname);
             }
@@ -1178,21 +1406,14 @@ bool CppGen::RemoveVar(const std::string& name, const std::string& scope)
     return true;
 }
 
-void CppGen::RemovePrefixedVars(const std::string& prefix, const std::string& scope)
+void CppGen::RemovePrefixedVars(const std::string& prefix, const std::string& type, const std::string& scope)
 {
     auto vit = m_fields.find(scope);
     if (vit == m_fields.end())
         return;
     stx::erase_if(vit->second, [&](const auto& var) 
     {
-        if (var.flags & Var::UserCode)
-            return false;
-        if (var.name.compare(0, prefix.size(), prefix))
-            return false;
-        for (size_t i = prefix.size(); i < var.name.size(); ++i)
-            if (!std::isdigit(var.name[i]))
-                return false;
-        return true;
+        return IsPrefixedVar(var, prefix, type);
     });
 }
 
@@ -12,11 +12,17 @@ public:
     static const std::string_view FOR_VAR_NAME;
     static const std::string_view HBOX_NAME;
     static const std::string_view VBOX_NAME;
+    static const std::string_view LABEL_CACHE_NAME;
+    static const std::string_view ROW_HEIGHTS_NAME;
+    static const std::string_view COMBO_INDEX_NAME;
+    static const std::string_view FONT_HANDLE_NAME;
 
     CppGen();
     bool ExportUpdate(const std::string& fname, TopWindow* node, const std::map<std::string, std::string>& params, std::string& err);
+    bool ExportUpdate(const std::string& hname, std::istream& hprev, std::ostream& hout, std::istream& fprev, std::ostream& fout, TopWindow* node, const std::map<std::string, std::string>& params, std::string& err, std::ostream* dout = nullptr);
     auto Import(const std::string& path, std::map<std::string, std::string>& params, std::string& err) -> std::unique_ptr<TopWindow>;
     static auto AltFName(const std::string& path) -> std::string;
+    static auto DrawFName(const std::string& path) -> std::string;
 
     const std::string& GetName() const { return m_name; }
     const std::string& GetVName() const { return m_vname; }
@@ -39,7 +45,7 @@ public:
     bool CreateNamedVar(const std::string& name, const std::string& type, const std::string& init, int flags, const std::string& scope = "");
     bool RenameVar(const std::string& oldn, const std::string& newn, const std::string& scope = "");
     bool RemoveVar(const std::string& name, const std::string& scope = "");
-    void RemovePrefixedVars(const std::string& prefix, const std::string& scope = "");
+    void RemovePrefixedVars(const std::string& prefix, const std::string& type, const std::string& scope = "");
     bool ChangeVar(const std::string& name, const std::string& type, const std::string& init, const std::string& scope = "");
     const Var* GetVar(const std::string& name, const std::string& scope = "") const;
     const std::vector<Var>& GetVars(const std::string& scope = "");
@@ -55,8 +61,12 @@ private:
 
     void CreateH(std::ostream& out);
     void CreateCpp(std::ostream& out);
-    auto ExportH(std::ostream& out, std::istream& prev, const std::string& origHName, TopWindow* node) -> std::array<std::string, 3>;
+    auto ExportH(std::ostream& out, std::istream& prev, const std::string& origHName, TopWindow* node, const std::vector<std::string>& headers) -> std::array<std::string, 3>;
     void ExportCpp(std::ostream& out, std::istream& prev, const std::array<std::string, 3>& origNames, const std::map<std::string, std::string>& params, TopWindow* node, const std::string& code);
+    void ExportDraw(std::ostream& out, const std::map<std::string, std::string>& params, TopWindow* node, const std::string& code);
+    bool IsDrawCacheVar(const Var& var) const;
+    auto GetRuntimeHeaders(TopWindow* node, const std::string& code) -> std::vector<std::string>;
+    bool InDrawFile(const std::string& id) const;
     bool WriteStub(std::ostream& fout,    const std::string& id, TopWindow::Kind kind, TopWindow::Placement animPos, const std::map<std::string, std::string>& params = {}, const std::string& code = {});
     auto ImportCode(std::istream& in, const std::string& fname, std::map<std::string, std::string>& params) -> std::unique_ptr<TopWindow>;
 
@@ -67,6 +77,7 @@ private:
 
     std::map<std::string, std::vector<Var>> m_fields;
     std::string m_name, m_vname, m_hname;
+    bool m_splitDraw = false;
     std::string ctx_workingDir;
     std::string m_error;
 };
\ No newline at end of file
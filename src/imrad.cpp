@@ -18,6 +18,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <chrono>
 #if defined(IMGUI_IMPL_OPENGL_ES2)
 #include <GLES2/gl2.h>
 #endif
@@ -37,6 +38,8 @@
 #include "ui_horiz_layout.h"
 #include "ui_input_name.h"
 #include "ui_settings_dlg.h"
+#include "imrad_style.h"
+#include "imrad_texture.h"
 
 //must come last
 #define STB_IMAGE_IMPLEMENTATION
@@ -44,7 +47,7 @@
 
 static void glfw_error_callback(int error, const char* description)
 {
-    std::cerr << "Glfw Error: " << description;
+    std::cerr << "Glfw Error: " << description << "\n";
 }
 
 const float TB_SIZE = 40;
@@ -53,6 +56,7 @@ const std::string UNTITLED = "Untitled";
 const std::string DEFAULT_STYLE = "Dark";
 const std::string DEFAULT_UNIT = "px";
 const char* INI_FILE_NAME = "imgui.ini";
+const double TAB_RELEASE_TIME = 10 * 60; //seconds of inactivity before unmodified tab is released
 
 struct File
 {
@@ -63,6 +67,9 @@ struct File
     fs::file_time_type time[2];
     std::string styleName;
     std::string unit;
+    bool splitDraw = false; //Draw goes to .draw.cpp
+    double lastActive = 0; //glfwGetTime of last activation
+    //rootNode == nullptr && fname != "" => tab wasn't imported yet or it was released
 };
 
 enum ProgramState { Run, Init, Shutdown };
@@ -145,6 +152,8 @@ void DoReloadFile()
     tab.styleName = pit == params.end() ? DEFAULT_STYLE : pit->second;
     pit = params.find("unit");
     tab.unit = pit == params.end() ? DEFAULT_UNIT : pit->second;
+    pit = params.find("splitDraw");
+    tab.splitDraw = pit != params.end() && pit->second == "true";
     bool styleFound = stx::count_if(styleNames, [&](const auto& st) {
         return st.first == tab.styleName;
         });
@@ -196,12 +205,74 @@ void ReloadFile()
     }
 }
 
+//imports a tab restored from ini or released by ReleaseInactiveTabs
+bool LoadTab(File& tab)
+{
+    std::string err;
+    std::error_code ec;
+    tab.time[0] = fs::last_write_time(tab.fname, ec);
+    tab.time[1] = fs::last_write_time(tab.codeGen.AltFName(tab.fname), ec);
+    std::map<std::string, std::string> params;
+    tab.codeGen = CppGen();
+    tab.rootNode = tab.codeGen.Import(tab.fname, params, err);
+    auto pit = params.find("style");
+    tab.styleName = pit == params.end() ? DEFAULT_STYLE : pit->second;
+    pit = params.find("unit");
+    tab.unit = pit == params.end() ? DEFAULT_UNIT : pit->second;
+    pit = params.find("splitDraw");
+    tab.splitDraw = pit != params.end() && pit->second == "true";
+    tab.modified = false;
+    if (!tab.rootNode)
+        err = "Unsuccessful import of '" + tab.fname + "'\n" + err;
+    
+    bool styleFound = stx::count_if(styleNames, [&](const auto& st) {
+        return st.first == tab.styleName;
+        });
+    if (tab.rootNode && !styleFound) {
+        err = "Unknown style \"" + tab.styleName + "\" used in '" + tab.fname + "'\n" + err;
+        tab.styleName = DEFAULT_STYLE;
+    }
+
+    if (err != "") {
+        if (programState == Init)
+            initErrors += err + "\n";
+        else if (programState != Shutdown) {
+            messageBox.title = "CodeGen";
+            messageBox.message = tab.rootNode ? "Import finished with errors" : "Unsuccessful import because of errors";
+            messageBox.error = err;
+            messageBox.buttons = ImRad::Ok;
+            messageBox.OpenPopup();
+        }
+    }
+    return tab.rootNode != nullptr;
+}
+
+//drops trees of unmodified tabs which weren't activated for a long time
+//they will be imported again in ActivateTab
+void ReleaseInactiveTabs()
+{
+    double time = glfwGetTime();
+    for (int i = 0; i < (int)fileTabs.size(); ++i)
+    {
+        auto& tab = fileTabs[i];
+        if (i == activeTab || tab.modified || tab.fname == "" || !tab.rootNode)
+            continue;
+        if (time - tab.lastActive < TAB_RELEASE_TIME)
+            continue;
+        tab.rootNode.reset();
+        tab.codeGen = CppGen();
+        Image::ReleaseTextures();
+    }
+}
+
 void ActivateTab(int i)
 {
     /*doesn't work when activeTab is closed
     std::string lastStyle;
     if (activeTab >= 0)
         lastStyle = fileTabs[activeTab].styleName;*/
+    if (activeTab >= 0 && activeTab < fileTabs.size())
+        fileTabs[activeTab].lastActive = glfwGetTime();
     if (i >= fileTabs.size())
         i = (int)fileTabs.size() - 1;
     if (i < 0) {
@@ -212,9 +283,24 @@ void ActivateTab(int i)
     }
     activeTab = i;
     auto& tab = fileTabs[i];
-    ctx.selected = { tab.rootNode.get() };
+    //closing tabs during shutdown doesn't need the content
+    if (!tab.rootNode && tab.fname != "" && programState != Shutdown) 
+    {
+        if (!LoadTab(tab)) {
+            fileTabs.erase(fileTabs.begin() + i);
+            activeTab = -1;
+            ActivateTab(i);
+            return;
+        }
+    }
+    tab.lastActive = glfwGetTime();
+    if (tab.rootNode)
+        ctx.selected = { tab.rootNode.get() };
+    else
+        ctx.selected.clear();
     ctx.codeGen = &tab.codeGen;
     ReloadFile();
+    ReleaseInactiveTabs();
 
     if (programState != Shutdown)
         reloadStyle = true;
@@ -328,7 +414,8 @@ void NewTemplate(int type)
         DoNewTemplate(type, "");
 }
 
-void DoOpenFile(const std::string& path, std::string* errs = nullptr)
+//lazy => only a tab stub is created and import happens on its activation
+void DoOpenFile(const std::string& path, std::string* errs = nullptr, bool lazy = false)
 {
     if (!fs::is_regular_file(path)) {
         if (errs)
@@ -342,6 +429,18 @@ void DoOpenFile(const std::string& path, std::string* errs = nullptr)
         return;
     }
 
+    if (lazy)
+    {
+        if (stx::count_if(fileTabs, [&](const File& f) { return f.fname == path; }))
+            return;
+        File file;
+        file.fname = path;
+        file.styleName = DEFAULT_STYLE;
+        file.unit = DEFAULT_UNIT;
+        fileTabs.push_back(std::move(file));
+        return;
+    }
+
     File file;
     file.fname = path;
     file.time[0] = fs::last_write_time(file.fname);
@@ -353,6 +452,8 @@ void DoOpenFile(const std::string& path, std::string* errs = nullptr)
     file.styleName = pit == params.end() ? DEFAULT_STYLE : pit->second;
     pit = params.find("unit");
     file.unit = pit == params.end() ? DEFAULT_UNIT : pit->second;
+    pit = params.find("splitDraw");
+    file.splitDraw = pit != params.end() && pit->second == "true";
     if (!file.rootNode) {
         if (errs)
             *errs += "Unsuccessful import of '" + path + "'\n";
@@ -438,6 +539,7 @@ void DoCloseFile()
     ctx.root = nullptr;
     ctx.selected.clear();
     fileTabs.erase(fileTabs.begin() + activeTab);
+    Image::ReleaseTextures();
     ActivateTab(activeTab);
     if (programState == Shutdown)
         CloseFile();
@@ -475,6 +577,8 @@ void DoSaveFile(bool thenClose)
         { "style", tab.styleName },
         { "unit", tab.unit },
     };
+    if (tab.splitDraw)
+        params["splitDraw"] = "true";
     if (!tab.codeGen.ExportUpdate(tab.fname, tab.rootNode.get(), params, messageBox.error))
     {
         DoCancelShutdown();
@@ -567,6 +671,8 @@ void SaveAll()
     int tmp = activeTab;
     for (activeTab = 0; activeTab < fileTabs.size(); ++activeTab)
     {
+        if (!fileTabs[activeTab].rootNode) //not loaded => nothing to save
+            continue;
         if (!SaveFile(false))
             break;
     }
@@ -776,6 +882,82 @@ GetCtxColors(const std::string& styleName)
         return classic;
 }
 
+//font atlas and parsed style kept for recently used styles so that switching
+//tabs only swaps io.Fonts and doesn't rasterize fonts again
+//only STYLE_CACHE_SIZE least recently used entries are kept
+const int STYLE_CACHE_SIZE = 3;
+
+struct StyleCache
+{
+    std::unique_ptr<ImFontAtlas> atlas;
+    GLuint texture = 0;
+    fs::file_time_type time;
+    std::string fontName;
+    float fontSize = 0;
+    ImGuiStyle style;
+    ImFont* defaultFont = nullptr;
+    std::vector<std::string> fontNames;
+    std::array<ImU32, UIContext::Color::COUNT> colors;
+    bool valid = false; //false after a failed load so it's retried next time
+    int lastUse = 0;
+};
+std::map<std::string, StyleCache> styleCache; //styleName -> cache
+int styleCacheUse = 0;
+ImFontAtlas* contextFontAtlas = nullptr;
+
+GLuint CreateFontsTexture(ImFontAtlas* atlas)
+{
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    
+    GLint lastTexture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+#if defined(GL_UNPACK_ROW_LENGTH) && !defined(__EMSCRIPTEN__)
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glBindTexture(GL_TEXTURE_2D, lastTexture);
+    atlas->SetTexID((ImTextureID)(intptr_t)texture);
+    return texture;
+}
+
+//call before backend shutdown, gives io.Fonts back to the ImGui context
+void ClearStyleCache()
+{
+    if (contextFontAtlas)
+        ImGui::GetIO().Fonts = contextFontAtlas;
+    for (auto& sc : styleCache) {
+        if (sc.second.texture)
+            glDeleteTextures(1, &sc.second.texture);
+        if (sc.second.atlas)
+            ImRad::FontTable::Remove(sc.second.atlas.get());
+    }
+    styleCache.clear();
+}
+
+//drops least recently used entries, the current one is always the most recent
+void PruneStyleCache()
+{
+    while ((int)styleCache.size() > STYLE_CACHE_SIZE)
+    {
+        auto lru = styleCache.begin();
+        for (auto it = styleCache.begin(); it != styleCache.end(); ++it)
+            if (it->second.lastUse < lru->second.lastUse)
+                lru = it;
+        if (lru->second.texture)
+            glDeleteTextures(1, &lru->second.texture);
+        if (lru->second.atlas)
+            ImRad::FontTable::Remove(lru->second.atlas.get());
+        styleCache.erase(lru);
+    }
+}
+
 void LoadStyle()
 {
     float faSize = fontSize * 18.f / 20.f;
@@ -785,10 +967,41 @@ void LoadStyle()
     
     reloadStyle = false;
     auto& io = ImGui::GetIO();
-    io.Fonts->Clear();
+    if (!contextFontAtlas)
+        contextFontAtlas = io.Fonts;
+    
+    std::string styleName = activeTab >= 0 ? fileTabs[activeTab].styleName : "";
+    auto sit = stx::find_if(styleNames, [&](const auto& s) { return s.first == styleName; });
+    fs::file_time_type time;
+    std::error_code err;
+    if (sit != styleNames.end() && sit->second != "")
+        time = fs::last_write_time(sit->second, err);
+    
+    StyleColors();
+    auto& cache = styleCache[styleName];
+    cache.lastUse = ++styleCacheUse;
+    PruneStyleCache();
+    if (cache.valid && cache.atlas && cache.time == time && 
+        cache.fontName == fontName && cache.fontSize == fontSize)
+    {
+        io.Fonts = cache.atlas.get();
+        ctx.style = cache.style;
+        ctx.defaultFont = cache.defaultFont;
+        ctx.fontNames = cache.fontNames;
+        ctx.colors = cache.colors;
+        return;
+    }
+
+    if (cache.texture)
+        glDeleteTextures(1, &cache.texture);
+    if (cache.atlas)
+        ImRad::FontTable::Remove(cache.atlas.get());
+    cache.valid = false;
+    cache.atlas = std::make_unique<ImFontAtlas>();
+    io.Fonts = cache.atlas.get();
+    bool loaded = true;
 
     //reload ImRAD UI first
-    StyleColors();
     io.Fonts->AddFontFromFileTTF(fontPath.c_str(), fontSize);
     static ImWchar icons_ranges[] = { ICON_MIN_FA, ICON_MAX_16_FA, 0 };
     ImFontConfig cfg;
@@ -809,7 +1022,6 @@ void LoadStyle()
     
     if (activeTab >= 0)
     {
-        std::string styleName = fileTabs[activeTab].styleName;
         if (styleName == "Classic")
         {
             ImGui::StyleColorsClassic(&ctx.style);
@@ -839,8 +1051,7 @@ void LoadStyle()
             std::map<std::string, ImFont*> fontMap;
             std::map<std::string, std::string> extra;
             try {
-                auto it = stx::find_if(styleNames, [&](const auto& s) { return s.first == styleName; });
-                ImRad::LoadStyle(it->second, 1.f, &ctx.style, &fontMap, &extra);
+                ImRad::LoadStyle(sit->second, 1.f, &ctx.style, &fontMap, &extra);
             
                 ctx.defaultFont = fontMap[""];
                 for (const auto& f : fontMap) {
@@ -870,11 +1081,22 @@ void LoadStyle()
             {
                 //can't OpenPopup here, there is no window parent
                 showError = e.what();
+                loaded = false;
             }
         }
     }
-    ImGui_ImplOpenGL3_DestroyFontsTexture();
-    ImGui_ImplOpenGL3_CreateFontsTexture();
+    
+    //atlas stays owned by the cache as io.Fonts uses it but a failed load
+    //isn't reused so fixing the style file doesn't need a restart
+    cache.texture = CreateFontsTexture(io.Fonts);
+    cache.valid = loaded;
+    cache.time = time;
+    cache.fontName = fontName;
+    cache.fontSize = fontSize;
+    cache.style = ctx.style;
+    cache.defaultFont = ctx.defaultFont;
+    cache.fontNames = ctx.fontNames;
+    cache.colors = ctx.colors;
 }
 
 void DoCloneStyle(const std::string& name)
@@ -1167,6 +1389,18 @@ void ToolbarUI()
         tab.modified = true;
     }
     ImGui::SameLine();
+    bool splitDraw = activeTab >= 0 && fileTabs[activeTab].splitDraw;
+    ImGui::BeginDisabled(activeTab < 0);
+    if (ImGui::Checkbox("Draw file", &splitDraw))
+    {
+        auto& tab = fileTabs[activeTab];
+        tab.splitDraw = splitDraw;
+        tab.modified = true;
+    }
+    ImGui::EndDisabled();
+    if (ImGui::IsItemHovered(ImGuiHoveredFlags_DelayNormal))
+        ImGui::SetTooltip("Generate Draw() and layout state into a separate .draw.cpp\nso the header doesn't change with the design");
+    ImGui::SameLine();
     ImGui::SeparatorEx(ImGuiSeparatorFlags_Vertical);
     
     ImGui::SameLine();
@@ -1904,7 +2138,7 @@ void AddINIHandler()
                         fileTabs.clear();
                         ActivateTab(-1);
                     }
-                    DoOpenFile(buf, &initErrors);
+                    DoOpenFile(buf, &initErrors, true);
                 }
                 else if (sscanf(line, "ActiveTab=%d", &i) == 1) {
                     ActivateTab(i);
@@ -1935,6 +2169,263 @@ void AddINIHandler()
     ImGui::GetCurrentContext()->SettingsHandlers.push_back(ini_handler);
 }
 
+//prints minimal line diff of the mismatching region
+void PrintDiff(std::ostream& os, const std::string& a, const std::string& b)
+{
+    auto split = [](const std::string& s) {
+        std::vector<std::string> lines;
+        std::istringstream is(s);
+        std::string line;
+        while (std::getline(is, line))
+            lines.push_back(line);
+        return lines;
+    };
+    auto la = split(a);
+    auto lb = split(b);
+    size_t pre = 0;
+    while (pre < la.size() && pre < lb.size() && la[pre] == lb[pre])
+        ++pre;
+    size_t post = 0;
+    while (post < la.size() - pre && post < lb.size() - pre &&
+        la[la.size() - 1 - post] == lb[lb.size() - 1 - post])
+        ++post;
+    
+    //LCS over the remaining middle part
+    size_t n = la.size() - pre - post;
+    size_t m = lb.size() - pre - post;
+    std::vector<std::vector<int>> lcs(n + 1, std::vector<int>(m + 1));
+    for (size_t i = n; i-- > 0; )
+        for (size_t j = m; j-- > 0; )
+            lcs[i][j] = la[pre + i] == lb[pre + j] ? lcs[i + 1][j + 1] + 1 :
+                std::max(lcs[i + 1][j], lcs[i][j + 1]);
+    
+    size_t i = 0, j = 0;
+    while (i < n || j < m)
+    {
+        if (i < n && j < m && la[pre + i] == lb[pre + j]) {
+            ++i;
+            ++j;
+        }
+        else if (j < m && (i == n || lcs[i][j + 1] >= lcs[i + 1][j])) {
+            os << "  +" << (pre + j + 1) << ": " << lb[pre + j] << "\n";
+            ++j;
+        }
+        else {
+            os << "  -" << (pre + i + 1) << ": " << la[pre + i] << "\n";
+            ++i;
+        }
+    }
+}
+
+//tokens of a source file, used to compare code regardless of blank lines.
+//Draw and ResetLayout members of skipClass are left out the same way
+//splitDraw export moves them into .draw.cpp
+std::vector<std::string> CppTokens(const std::string& code, const std::string& skipClass = "")
+{
+    std::istringstream in(code);
+    std::vector<std::string> toks;
+    int level = 0;
+    int skipLevel = -1;
+    for (cpp::token_iterator it(in); it != cpp::token_iterator(); ++it)
+    {
+        if (skipLevel < 0)
+            toks.push_back(*it);
+        if (*it == "{") {
+            size_t n = toks.size();
+            if (!level && skipClass != "" && n >= 7 &&
+                toks[n - 7] == "void" && toks[n - 6] == skipClass && toks[n - 5] == "::" &&
+                (toks[n - 4] == "Draw" || toks[n - 4] == "ResetLayout") &&
+                toks[n - 3] == "(" && toks[n - 2] == ")")
+            {
+                toks.resize(n - 7);
+                skipLevel = level;
+            }
+            ++level;
+        }
+        else if (*it == "}") {
+            if (--level == skipLevel)
+                skipLevel = -1;
+        }
+    }
+    return toks;
+}
+
+//quoted json string, non-ascii bytes are passed as they are (utf8)
+std::string JsonString(std::string_view s)
+{
+    std::string str = "\"";
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\') {
+            str += '\\';
+            str += c;
+        }
+        else if ((unsigned char)c < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            str += buf;
+        }
+        else
+            str += c;
+    }
+    str += '"';
+    return str;
+}
+
+//Imports every generated file pair in dir, exports it again into memory 
+//and compares with the original. Files without .draw.cpp are also
+//exported with splitDraw to check only the moved functions get cut. Timings are optionally written as json
+int RoundTrip(const std::string& dir, const std::string& jsonPath, int repeat)
+{
+    struct Result {
+        std::string name;
+        bool ok;
+        double importMs, exportMs;
+    };
+    std::vector<Result> results;
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(dir, ec))
+    {
+        const auto& path = entry.path();
+        if (path.extension() != ".cpp" || !fs::is_regular_file(CppGen::AltFName(path.string())))
+            continue;
+        for (const auto& fpath : { path, fs::path(CppGen::DrawFName(path.string())) })
+        {
+            std::ifstream fin(fpath);
+            std::string line;
+            while (std::getline(fin, line) && line.find("/// @begin TopWindow") == std::string::npos)
+                ;
+            if (fin) {
+                files.push_back(path);
+                break;
+            }
+        }
+    }
+    if (ec) {
+        std::cerr << "Can't read '" << dir << "'\n";
+        return 1;
+    }
+    stx::sort(files);
+
+    int failed = 0;
+    for (const auto& path : files)
+    {
+        std::stringstream origH, origCpp, origDraw;
+        std::ifstream fin(fs::path(path).replace_extension(".h"));
+        std::string line;
+        while (std::getline(fin, line))
+            origH << line << "\n";
+        fin.close();
+        fin.open(path);
+        while (std::getline(fin, line))
+            origCpp << line << "\n";
+        fin.close();
+        fin.open(CppGen::DrawFName(path.string()));
+        while (std::getline(fin, line))
+            origDraw << line << "\n";
+        fin.close();
+
+        Result res{ path.filename().string(), true, 0, 0 };
+        std::string hout, cppout, drawout, err;
+        for (int n = 0; n < repeat; ++n)
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            CppGen codeGen;
+            std::map<std::string, std::string> params;
+            std::string importErr;
+            auto node = codeGen.Import(path.string(), params, importErr);
+            auto t1 = std::chrono::steady_clock::now();
+            if (!node) {
+                err = importErr;
+                res.ok = false;
+                break;
+            }
+            std::stringstream hprev(origH.str()), cppprev(origCpp.str());
+            std::ostringstream hos, cppos, drawos;
+            err = "";
+            res.ok = codeGen.ExportUpdate(path.stem().string() + ".h", hprev, hos, cppprev, cppos, node.get(), params, err, &drawos);
+            auto t2 = std::chrono::steady_clock::now();
+            res.importMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+            res.exportMs += std::chrono::duration<double, std::milli>(t2 - t1).count();
+            hout = hos.str();
+            cppout = cppos.str();
+            drawout = drawos.str();
+        }
+        res.importMs /= repeat;
+        res.exportMs /= repeat;
+        
+        if (res.ok && (hout != origH.str() || cppout != origCpp.str() || drawout != origDraw.str()))
+            res.ok = false;
+
+        //moving Draw out must not leave anything behind, even when it is the last function
+        std::string splitCpp, splitExpected;
+        if (res.ok && origDraw.str() == "")
+        {
+            CppGen codeGen;
+            std::map<std::string, std::string> params;
+            auto node = codeGen.Import(path.string(), params, err);
+            params["splitDraw"] = "true";
+            std::stringstream hprev(origH.str()), cppprev(origCpp.str());
+            std::ostringstream hos, cppos, drawos;
+            err = "";
+            res.ok = node && codeGen.ExportUpdate(path.stem().string() + ".h", hprev, hos, cppprev, cppos, node.get(), params, err, &drawos);
+            if (res.ok) {
+                splitCpp = stx::join(CppTokens(cppos.str()), "\n");
+                splitExpected = stx::join(CppTokens(origCpp.str(), codeGen.GetName()), "\n");
+                res.ok = splitCpp == splitExpected && drawos.str() != "";
+            }
+        }
+        if (!res.ok)
+        {
+            ++failed;
+            std::cout << "FAILED " << res.name << "\n";
+            if (err != "")
+                std::cout << err;
+            if (hout != "" && hout != origH.str())
+                PrintDiff(std::cout, origH.str(), hout);
+            if (cppout != "" && cppout != origCpp.str())
+                PrintDiff(std::cout, origCpp.str(), cppout);
+            if (drawout != origDraw.str())
+                PrintDiff(std::cout, origDraw.str(), drawout);
+            if (splitCpp != splitExpected) {
+                std::cout << "  with splitDraw:\n";
+                PrintDiff(std::cout, splitExpected, splitCpp);
+            }
+        }
+        else
+        {
+            std::cout << "OK " << res.name << " import " << res.importMs 
+                << "ms export " << res.exportMs << "ms\n";
+        }
+        results.push_back(res);
+    }
+    std::cout << (results.size() - failed) << "/" << results.size() << " files passed\n";
+
+    if (jsonPath != "")
+    {
+        std::ofstream fout(jsonPath);
+        if (!fout) {
+            std::cerr << "Can't write to '" << jsonPath << "'\n";
+            return 1;
+        }
+        fout << "{\n  \"version\": " << JsonString(VER_STR) << ",\n";
+        fout << "  \"repeat\": " << repeat << ",\n";
+        fout << "  \"files\": [";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const auto& res = results[i];
+            fout << (i ? ",\n" : "\n") 
+                << "    { \"name\": " << JsonString(res.name)
+                << ", \"ok\": " << (res.ok ? "true" : "false")
+                << ", \"import_ms\": " << res.importMs
+                << ", \"export_ms\": " << res.exportMs << " }";
+        }
+        fout << "\n  ]\n}\n";
+    }
+    return failed ? 1 : 0;
+}
+
 std::string GetRootPath()
 {
 #ifdef WIN32
@@ -1967,12 +2458,65 @@ int WINAPI wWinMain(
 int main(int argc, const char* argv[]) 
 {
 #endif    
+#if (WIN32) && !(__MINGW32__)
+    std::vector<std::string> args;
+    for (int i = 1; i < __argc; ++i)
+        args.push_back(fs::path(__wargv[i]).string());
+#else
+    std::vector<std::string> args(argv + 1, argv + argc);
+#endif
+    //imrad --roundtrip <dir> [--json timings.json] [--repeat N]
+    //imrad --compile-style <style.ini> <style.bin>
+    std::string roundTripDir, roundTripJson;
+    std::string compileStyleIni, compileStyleOut;
+    int roundTripRepeat = 1;
+    for (size_t i = 0; i + 1 < args.size(); ++i)
+    {
+        if (args[i] == "--compile-style" && i + 2 < args.size()) {
+            compileStyleIni = args[++i];
+            compileStyleOut = args[++i];
+        }
+        else if (args[i] == "--roundtrip")
+            roundTripDir = args[++i];
+        else if (args[i] == "--json")
+            roundTripJson = args[++i];
+        else if (args[i] == "--repeat")
+            roundTripRepeat = std::max(1, std::atoi(args[++i].c_str()));
+    }
+
     rootPath = GetRootPath();
 
+    if (compileStyleIni != "")
+    {
+        //fonts are rasterized on CPU, no window or GL context needed
+        ImGui::CreateContext();
+        int ret = 0;
+        try {
+            ImRad::CompileStyle(compileStyleIni, compileStyleOut);
+        }
+        catch (std::exception& e) {
+            std::cerr << e.what() << "\n";
+            ret = 1;
+        }
+        ImGui::DestroyContext();
+        return ret;
+    }
+
+    if (roundTripDir != "")
+    {
+        //runs headless, Image textures aren't loaded without GL context
+        ImGui::CreateContext();
+        int ret = RoundTrip(roundTripDir, roundTripJson, roundTripRepeat);
+        ImGui::DestroyContext();
+        return ret;
+    }
+
     // Setup window
     glfwSetErrorCallback(glfw_error_callback);
-    if (!glfwInit())
+    if (!glfwInit()) {
+        std::cerr << "Can't initialize GLFW\n";
         return 1;
+    }
 
     // Decide GL+GLSL versions
 #if defined(IMGUI_IMPL_OPENGL_ES2)
@@ -2002,8 +2546,13 @@ int main(int argc, const char* argv[])
 
     // Create window with graphics context
     window = glfwCreateWindow(1280, 720, VER_STR.c_str(), NULL, NULL);
-    if (window == NULL)
+    if (window == NULL) {
+        //reason was reported by glfw_error_callback
+        std::cerr << "Can't create window\n";
+        NFD_Quit();
+        glfwTerminate();
         return 1;
+    }
     GLFWimage icons[2];
     icons[0].pixels = stbi_load((rootPath + "/style/icon-40.png").c_str(), &icons[0].width, &icons[0].height, 0, 4);
     icons[1].pixels = stbi_load((rootPath + "/style/icon-100.png").c_str(), &icons[1].width, &icons[1].height, 0, 4);
@@ -2032,6 +2581,8 @@ int main(int argc, const char* argv[])
     // Setup Platform/Renderer backends
     ImGui_ImplGlfw_InitForOpenGL(window, true);
     ImGui_ImplOpenGL3_Init(glsl_version);
+    //backend owns the context atlas texture, style atlases are managed by LoadStyle
+    ImGui_ImplOpenGL3_CreateDeviceObjects();
     const ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
     ctx.dashTexId = ImRad::LoadTextureFromFile(
         (rootPath + "/style/dash.png").c_str(), GL_NEAREST, GL_NEAREST, GL_REPEAT, GL_REPEAT).id;
@@ -2086,8 +2637,10 @@ int main(int argc, const char* argv[])
         ImGui::NewFrame();
 
         bool visible = glfwGetWindowAttrib(window, GLFW_FOCUSED);
-        if (visible && !lastVisible)
+        if (visible && !lastVisible) {
             ReloadFile();
+            Image::CheckTextureFiles();
+        }
         lastVisible = visible;
 
         DockspaceUI();
@@ -2115,6 +2668,11 @@ int main(int argc, const char* argv[])
     // Cleanup
     NFD_Quit();
 
+    //release shared Image textures while GL context still exists
+    fileTabs.clear();
+    clipboard.clear();
+    newNode.reset();
+    ClearStyleCache();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
@@ -1,28 +1,27 @@
 #pragma once
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <functional> //for ModalPopup callback
-#include <fstream> //Save/LoadStyle
-#include <iomanip> //std::quoted
-#include <sstream> 
-#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+#include <cmath>
 #include <imgui.h>
 #include <imgui_internal.h> //CurrentItemFlags, GetCurrentWindow, PushOverrideID
 #include <misc/cpp/imgui_stdlib.h> //for Input(std::string)
 
-#ifdef IMRAD_WITH_FMT
-#include <fmt/format.h>
-#endif
+//Core runtime needed by all generated code. Heavier parts are opt-in 
+//and ImRAD #includes them in the generated header when they are used:
+//  imrad_animator.h - Animator for animated popups
+//  imrad_format.h   - Format, FrameFormat and LabelCache for bound labels
+//  imrad_texture.h  - LoadTextureFromFile/LoadTextureAsync
+//  imrad_style.h    - LoadStyle/SaveStyle and the binary style cache
 
 #ifdef IMRAD_WITH_GLFW
 #include <GLFW/glfw3.h> //enables kind=MainWindow
-#ifndef GL_CLAMP_TO_EDGE
-#define GL_CLAMP_TO_EDGE 0x812F
-#endif
-#ifdef IMRAD_WITH_STB
-#include <stb_image.h> //for LoadTextureFromFile
-#endif
 #endif
 
 namespace ImRad {
@@ -109,81 +108,10 @@ struct IOUserData
     }
 };
 
-struct Animator 
-{
-    //todo: configure
-    static inline const float DurOpenPopup = 0.4f; 
-    static inline const float DurClosePopup = 0.3f;
-
-    void StartAlways(float *v, float s, float e, float dur) 
-    {
-        Var nvar{ 0, v, s, e, dur, false };
-        for (auto& var : vars)
-            if (var.var == v) {
-                var = nvar;
-                return;
-            }
-        vars.push_back(nvar);
-    }
-    void StartOnce(float *v, float s, float e, float dur) 
-    {
-        Var nvar{ 0, v, s, e, dur, true };
-        for (auto& var : vars)
-            if (var.var == v) {
-                var = nvar;
-                return;
-            }
-        vars.push_back(nvar);
-    }
-    bool IsDone() const 
-    {
-        for (const auto& var : vars)
-            if (var.oneShot || std::abs(*var.var - var.end) / std::abs(var.end - var.start) > 0.01)
-                return false;
-        return true;
-    }
-    //to be called from withing Begin
-    void Tick() 
-    {
-        wsize = ImGui::GetCurrentWindow()->Size; //cache actual windows size
-        size_t j = 0;
-        for (size_t i = 0; i < vars.size(); ++i) {
-            auto& var = vars[i];
-            var.time += ImGui::GetIO().DeltaTime;
-            float distance = var.end - var.start;
-            float x = var.time / var.duration;
-            if (x > 1)
-                x = 1.f;
-            float y = 1 - (1 - x) * (1 - x); //easeOutQuad
-            *var.var = var.start + y * distance;
-            if (!var.oneShot || std::abs(x - 1.0) >= 0.01) { //keep current var
-                if (j < i)
-                    vars[j] = var;
-                ++j;
-            }
-        }
-        vars.resize(j);
-    }
-    ImVec2 GetWindowSize() const 
-    {
-        return wsize;
-    }
-
-private:
-    struct Var 
-    {
-        float time;
-        float* var = nullptr;
-        float start, end;
-        float duration;
-        bool oneShot;
-    };
-    std::vector<Var> vars;
-    ImVec2 wsize{ 0, 0 };
-};
-
 
-template <bool HORIZ>
+//N items are stored inline, more items spill into a vector which keeps its capacity
+//so there is no heap traffic in steady state
+template <bool HORIZ, size_t N = 16>
 struct BoxLayout
 {
     static constexpr float ItemSize = 0;
@@ -195,18 +123,20 @@ struct BoxLayout
 
     void Reset()
     {
-        prevItems.clear();
+        prevItems().clear();
     }
     void BeginLayout() 
     {
         pos1 = HORIZ ? ImGui::GetCursorPosX() : ImGui::GetCursorPosY();
-        std::swap(prevItems, items);
-        items.clear();
+        cur ^= 1; //swap items, prevItems
+        items().clear();
         
+        ItemBuffer& prev = prevItems();
         float avail = HORIZ ? ImGui::GetContentRegionAvail().x : ImGui::GetContentRegionAvail().y;
         float total = 0;
         float stretchTotal = 0;
-        for (Item& it : prevItems) {
+        for (size_t i = 0; i < prev.size(); ++i) {
+            Item& it = prev[i];
             //it.spacing = (int)it.spacing;
             //it.size = (int)it.size;
             total += it.spacing;
@@ -220,7 +150,8 @@ struct BoxLayout
             else
                 total += it.size;
         }
-        for (Item& it : prevItems) {
+        for (size_t i = 0; i < prev.size(); ++i) {
+            Item& it = prev[i];
             if (it.stretch)
                 it.size = (float)(int)(it.size * (avail - total) / stretchTotal);
             else if (it.size < 0)
@@ -234,21 +165,21 @@ struct BoxLayout
         float spacing = sp * (HORIZ ? ImGui::GetStyle().ItemSpacing.x : ImGui::GetStyle().ItemSpacing.y);
         if (size == ItemSize)
             size = HORIZ ? ImGui::GetItemRectSize().x : ImGui::GetItemRectSize().y;
-        items.push_back({ spacing, size, false });
+        items().push_back({ spacing, size, false });
     }
     void AddSize(int sp, Stretch size)
     {
         float spacing = sp * (HORIZ ? ImGui::GetStyle().ItemSpacing.x : ImGui::GetStyle().ItemSpacing.y);
-        items.push_back({ spacing, size.value, true });
+        items().push_back({ spacing, size.value, true });
     }
     //call after a widget call for vert layout having multiple widgets in a row
     void UpdateSize(float sp, float size)
     {
-        assert(items.size());
+        assert(items().size());
         float spacing = sp * (HORIZ ? ImGui::GetStyle().ItemSpacing.x : ImGui::GetStyle().ItemSpacing.y);
         if (size == ItemSize)
             size = HORIZ ? ImGui::GetItemRectSize().x : ImGui::GetItemRectSize().y;
-        Item& it = items.back();
+        Item& it = items().back();
         if (spacing > it.spacing)
             it.spacing = spacing;
         if (!it.stretch && (size > it.size || (size < 0 && it.size > 0)))
@@ -256,9 +187,9 @@ struct BoxLayout
     }
     void UpdateSize(float sp, Stretch size)
     {
-        assert(items.size());
+        assert(items().size());
         float spacing = sp * (HORIZ ? ImGui::GetStyle().ItemSpacing.x : ImGui::GetStyle().ItemSpacing.y);
-        Item& it = items.back();
+        Item& it = items().back();
         if (spacing > it.spacing)
             it.spacing = spacing;
         if (!it.stretch || size.value > it.size) {
@@ -269,14 +200,16 @@ struct BoxLayout
     //unused - for use in SetCursorX/Y
     float GetPos()
     {
-        if (prevItems.size() <= items.size()) //stop positioning - widgets changed
+        ItemBuffer& prev = prevItems();
+        size_t n = items().size();
+        if (prev.size() <= n) //stop positioning - widgets changed
             return HORIZ ? ImGui::GetCursorPosX() : ImGui::GetCursorPosY();
         float pos = pos1;
-        for (size_t i = 0; i < items.size(); ++i) {
-            pos += prevItems[i].size + prevItems[i].spacing;
+        for (size_t i = 0; i < n; ++i) {
+            pos += prev[i].size + prev[i].spacing;
         }
-        if (prevItems.size() > items.size())
-            pos += prevItems[items.size()].spacing;
+        if (prev.size() > n)
+            pos += prev[n].spacing;
         return pos;
     }
     //deprecated
@@ -288,10 +221,10 @@ struct BoxLayout
     float GetSize(bool deprecatedSameLine = false)
     {
         bool sameLine = !HORIZ && ImGui::GetCurrentWindow()->DC.IsSameLine;
-        size_t i = sameLine ? items.size() - 1 : items.size();
-        if (i >= prevItems.size()) //widgets changed
+        size_t i = sameLine ? items().size() - 1 : items().size();
+        if (i >= prevItems().size()) //widgets changed
             return 0;
-        return prevItems[i].size;
+        return prevItems()[i].size;
     }
 
 private:
@@ -301,7 +234,29 @@ private:
         bool stretch;
     };
 
-    std::vector<Item> items, prevItems;
+    struct ItemBuffer {
+        Item buf[N];
+        std::vector<Item> more;
+        size_t count = 0;
+
+        size_t size() const { return count; }
+        void clear() { count = 0; more.clear(); }
+        Item& operator[] (size_t i) { return i < N ? buf[i] : more[i - N]; }
+        Item& back() { return (*this)[count - 1]; }
+        void push_back(const Item& it) {
+            if (count < N)
+                buf[count] = it;
+            else
+                more.push_back(it);
+            ++count;
+        }
+    };
+
+    ItemBuffer& items() { return bufs[cur]; }
+    ItemBuffer& prevItems() { return bufs[cur ^ 1]; }
+
+    ItemBuffer bufs[2];
+    int cur = 0;
     float pos1;
 };
 
@@ -354,6 +309,222 @@ inline bool Combo(const char* label, std::string* curr, const char* items, int f
     return changed;
 }
 
+//Combo state for large item lists
+//Keeps item pointers, the cached selected index and a sorted lowercase index
+//for prefix filtering. Popup items are clipped so only visible ones are submitted
+//Vector items are reindexed when any item's storage or size changes, call 
+//Invalidate after editing their content in place otherwise. Packed const char* 
+//items are copied and compared each frame
+class ComboIndex
+{
+public:
+    void Invalidate()
+    {
+        source = nullptr;
+    }
+    //items are revalidated only while the popup is open, closed combo is O(1)
+    bool Combo(const char* label, int* curr, const std::vector<std::string>& items, int flags = 0, bool filter = false)
+    {
+        const char* preview = *curr >= 0 && *curr < (int)items.size() ? items[*curr].c_str() : "";
+        if (!ImGui::BeginCombo(label, preview, flags))
+            return false;
+        Update(items);
+        return DoList(curr, filter);
+    }
+    bool Combo(const char* label, int* curr, const char* items, int flags = 0, bool filter = false)
+    {
+        //preview comes from our copy which is refreshed on a new buffer or when opened
+        if (source != items)
+            Update(items);
+        const char* preview = *curr >= 0 && *curr < (int)names.size() ? names[*curr] : "";
+        if (!ImGui::BeginCombo(label, preview, flags))
+            return false;
+        Update(items);
+        return DoList(curr, filter);
+    }
+    bool Combo(const char* label, std::string* curr, const std::vector<std::string>& items, int flags = 0, bool filter = false)
+    {
+        if (!ImGui::BeginCombo(label, curr->c_str(), flags))
+            return false;
+        Update(items);
+        return DoList(curr, filter);
+    }
+    bool Combo(const char* label, std::string* curr, const char* items, int flags = 0, bool filter = false)
+    {
+        if (!ImGui::BeginCombo(label, curr->c_str(), flags))
+            return false;
+        Update(items);
+        return DoList(curr, filter);
+    }
+
+private:
+    void Update(const std::vector<std::string>& items)
+    {
+        //assigning an item can reallocate it so check every item
+        bool same = source == items.data() && names.size() == items.size();
+        for (size_t i = 0; same && i < items.size(); ++i)
+            same = names[i] == items[i].c_str() && sizes[i] == items[i].size();
+        if (same)
+            return;
+        Reset(items.data());
+        names.reserve(items.size());
+        sizes.reserve(items.size());
+        for (const auto& item : items) {
+            names.push_back(item.c_str());
+            sizes.push_back(item.size());
+        }
+    }
+    void Update(const char* items)
+    {
+        //buffer can be edited in place so names point to our copy
+        size_t i = 0;
+        while (i < packed.size() && items[i] == packed[i])
+            ++i;
+        if (source == items && i == packed.size())
+            return;
+        Reset(items);
+        const char* p = items;
+        while (*p)
+            p += strlen(p) + 1;
+        packed.assign(items, p + 1);
+        for (p = packed.data(); *p; p += strlen(p) + 1)
+            names.push_back(p);
+    }
+    void Reset(const void* src)
+    {
+        source = src;
+        names.clear();
+        sizes.clear();
+        lower.clear();
+        selected = -1;
+        hasMissing = false;
+        UpdateFilter();
+    }
+    //O(1) while curr stays at the cached index
+    int Find(const std::string& curr)
+    {
+        if (selected >= 0 && curr == names[selected])
+            return selected;
+        if (hasMissing && curr == missing)
+            return -1;
+        selected = -1;
+        for (size_t i = 0; i < names.size(); ++i)
+            if (curr == names[i]) {
+                selected = (int)i;
+                break;
+            }
+        hasMissing = selected < 0;
+        if (hasMissing)
+            missing = curr;
+        return selected;
+    }
+    bool DoList(std::string* curr, bool filter)
+    {
+        int index = Find(*curr);
+        if (!DoList(&index, filter))
+            return false;
+        *curr = names[index];
+        selected = index;
+        return true;
+    }
+    //call after BeginCombo returned true, ends the combo
+    bool DoList(int* curr, bool filter)
+    {
+        bool changed = false;
+        bool appearing = ImGui::IsWindowAppearing();
+        if (filter)
+        {
+            if (appearing) {
+                filterText.clear();
+                UpdateFilter();
+                ImGui::SetKeyboardFocusHere();
+            }
+            ImGui::SetNextItemWidth(-1);
+            if (ImGui::InputText("##filter", &filterText))
+                UpdateFilter();
+        }
+        bool filtered = filter && !filterText.empty();
+        int count = filtered ? (int)matches.size() : (int)names.size();
+        int selRow = -1;
+        if (appearing && *curr >= 0 && *curr < (int)names.size()) {
+            if (!filtered)
+                selRow = *curr;
+            else {
+                auto it = std::lower_bound(matches.begin(), matches.end(), *curr);
+                if (it != matches.end() && *it == *curr)
+                    selRow = int(it - matches.begin());
+            }
+        }
+        ImGuiListClipper clipper;
+        clipper.Begin(count);
+        if (selRow >= 0)
+            clipper.IncludeItemByIndex(selRow);
+        while (clipper.Step())
+        {
+            for (int r = clipper.DisplayStart; r < clipper.DisplayEnd; ++r)
+            {
+                int i = filtered ? matches[r] : r;
+                if (ImGui::Selectable(names[i], i == *curr)) {
+                    *curr = i;
+                    changed = true;
+                }
+                if (r == selRow)
+                    ImGui::SetItemDefaultFocus();
+            }
+        }
+        ImGui::EndCombo();
+        return changed;
+    }
+    void UpdateFilter()
+    {
+        matches.clear();
+        if (filterText.empty())
+            return;
+        if (lower.empty()) {
+            lower.resize(names.size());
+            for (size_t i = 0; i < names.size(); ++i)
+                lower[i] = { ToLower(names[i]), (int)i };
+            std::sort(lower.begin(), lower.end());
+        }
+        std::string key = ToLower(filterText);
+        auto it = std::lower_bound(lower.begin(), lower.end(), key,
+            [](const auto& a, const std::string& k) { return a.first < k; });
+        for (; it != lower.end() && !it->first.compare(0, key.size(), key); ++it)
+            matches.push_back(it->second);
+        //keep original item order
+        std::sort(matches.begin(), matches.end());
+    }
+    static std::string ToLower(std::string_view str)
+    {
+        std::string tmp(str);
+        for (char& c : tmp)
+            if (c >= 'A' && c <= 'Z')
+                c += 'a' - 'A';
+        return tmp;
+    }
+
+    const void* source = nullptr;
+    std::vector<const char*> names;
+    std::vector<size_t> sizes;
+    std::string packed;
+    std::vector<std::pair<std::string, int>> lower;
+    std::vector<int> matches;
+    std::string filterText;
+    int selected = -1;
+    std::string missing;
+    bool hasMissing = false;
+};
+
+inline bool Combo(const char* label, std::string* curr, const std::vector<std::string>& items, int flags, ComboIndex& index, bool filter = false)
+{
+    return index.Combo(label, curr, items, flags, filter);
+}
+
+inline bool Combo(const char* label, std::string* curr, const char* items, int flags, ComboIndex& index, bool filter = false)
+{
+    return index.Combo(label, curr, items, flags, filter);
+}
+
 inline void Dummy(const ImVec2& size)
 {
     //ImGui Dummy doesn't support negative dimensions like other controls
@@ -447,6 +618,210 @@ inline void NextColumn(int n)
         ImGui::NextColumn();
 }
 
+//Heights of variable height items in a virtualized loop. Items are measured when
+//submitted and prefix sums kept in a Fenwick tree map scroll offset to item index
+//in O(log n). Items which weren't visible yet use the last measured height.
+//Call Invalidate when item data change so they are remeasured
+class RowHeights
+{
+public:
+    void Invalidate() 
+    {
+        std::fill(heights.begin(), heights.end(), estimate);
+        Rebuild();
+    }
+    void Invalidate(int i)
+    {
+        if (i >= 0 && i < (int)heights.size())
+            Set(i, estimate);
+    }
+    int Size() const { return (int)heights.size(); }
+    float Height(int i) const { return heights[i]; }
+    //sum of heights of the first i items
+    float Offset(int i) const
+    {
+        double sum = 0;
+        for (; i > 0; i -= i & -i)
+            sum += tree[i];
+        return (float)sum;
+    }
+    //index of the item containing offset y
+    int Find(float y) const
+    {
+        int n = (int)heights.size();
+        int pos = 0;
+        int step = 1;
+        while (2 * step <= n)
+            step *= 2;
+        for (; step; step /= 2)
+        {
+            if (pos + step <= n && tree[pos + step] <= y) {
+                pos += step;
+                y -= (float)tree[pos];
+            }
+        }
+        return pos;
+    }
+    void Resize(int n, float defHeight)
+    {
+        if (n == (int)heights.size())
+            return;
+        if (!estimate)
+            estimate = defHeight;
+        heights.resize(n, estimate);
+        Rebuild();
+    }
+    void Set(int i, float h)
+    {
+        estimate = h;
+        double d = h - heights[i];
+        if (!d)
+            return;
+        heights[i] = h;
+        for (++i; i < (int)tree.size(); i += i & -i)
+            tree[i] += d;
+    }
+
+private:
+    void Rebuild()
+    {
+        int n = (int)heights.size();
+        tree.assign(n + 1, 0);
+        for (int i = 1; i <= n; ++i)
+        {
+            tree[i] += heights[i - 1];
+            int j = i + (i & -i);
+            if (j <= n)
+                tree[j] += tree[i];
+        }
+    }
+
+    std::vector<float> heights;
+    std::vector<double> tree; //1-based
+    float estimate = 0;
+};
+
+//ImGuiListClipper driven loop used by generated code for virtualized data loops:
+//for (int i = ClipperBegin(n, h); i < n; i = ClipperNext(i))
+//Only visible items are submitted. Loops can nest but mustn't be left with break
+struct ClipperStack
+{
+    struct Entry
+    {
+        std::unique_ptr<ImGuiListClipper> clipper;
+        RowHeights* rows = nullptr; //variable height mode
+        float itemY = 0;
+    };
+    std::vector<Entry> entries;
+    int depth = 0;
+
+    static ClipperStack& Get()
+    {
+        static ClipperStack stack;
+        return stack;
+    }
+
+    //ends current table row, returns where the next item starts
+    static float ItemEndY()
+    {
+        ImGuiContext& g = *GImGui;
+        ImGuiTable* table = g.CurrentTable;
+        if (table && table->InnerWindow == g.CurrentWindow) {
+            if (table->IsInsideRow)
+                ImGui::TableEndRow(table);
+            return table->RowPosY2;
+        }
+        return g.CurrentWindow->DC.CursorPos.y;
+    }
+
+    //moves cursor over items which are not submitted
+    static void SeekY(float y, int skipped)
+    {
+        ImGuiContext& g = *GImGui;
+        ImGuiWindow* window = g.CurrentWindow;
+        window->DC.CursorPos.y = y;
+        window->DC.CursorMaxPos.y = ImMax(window->DC.CursorMaxPos.y, y - g.Style.ItemSpacing.y);
+        ImGuiTable* table = g.CurrentTable;
+        if (table && table->InnerWindow == window) {
+            if (table->IsInsideRow)
+                ImGui::TableEndRow(table);
+            table->RowPosY2 = y;
+            table->RowBgColorCounter += skipped;
+        }
+    }
+};
+
+inline int ClipperNext(int i)
+{
+    auto& cs = ClipperStack::Get();
+    IM_ASSERT(cs.depth > 0);
+    auto& entry = cs.entries[cs.depth - 1];
+    if (entry.rows)
+    {
+        //measure submitted item and continue until the visible area is filled
+        RowHeights& rows = *entry.rows;
+        float y = ClipperStack::ItemEndY();
+        if (i >= 0 && i < rows.Size())
+            rows.Set(i, y - entry.itemY);
+        entry.itemY = y;
+        float maxY = ImGui::GetCurrentWindow()->InnerClipRect.Max.y;
+        if (i + 1 < rows.Size() && y < maxY)
+            return i + 1;
+        int n = rows.Size();
+        ClipperStack::SeekY(y + rows.Offset(n) - rows.Offset(i + 1), n - i - 1);
+        --cs.depth;
+        return std::numeric_limits<int>::max();
+    }
+    
+    ImGuiListClipper& clipper = *entry.clipper;
+    if (i + 1 < clipper.DisplayEnd)
+        return i + 1;
+    while (clipper.Step())
+    {
+        if (clipper.DisplayStart < clipper.DisplayEnd)
+            return clipper.DisplayStart;
+    }
+    --cs.depth;
+    //terminates the loop even when item count changed in the meantime
+    return std::numeric_limits<int>::max();
+}
+
+inline int ClipperBegin(int n, float itemHeight = -1)
+{
+    auto& cs = ClipperStack::Get();
+    if (cs.depth == (int)cs.entries.size())
+        cs.entries.emplace_back();
+    auto& entry = cs.entries[cs.depth++];
+    if (!entry.clipper)
+        entry.clipper = std::make_unique<ImGuiListClipper>();
+    entry.rows = nullptr;
+    entry.clipper->Begin(n, itemHeight > 0 ? itemHeight : -1);
+    return ClipperNext(-1);
+}
+
+//variable item height version, rows keep measured heights between frames
+inline int ClipperBegin(int n, RowHeights& rows)
+{
+    auto& cs = ClipperStack::Get();
+    if (cs.depth == (int)cs.entries.size())
+        cs.entries.emplace_back();
+    auto& entry = cs.entries[cs.depth++];
+    entry.rows = &rows;
+    rows.Resize(std::max(n, 0), ImGui::GetFrameHeightWithSpacing());
+    float y0 = ClipperStack::ItemEndY();
+    float minY = ImGui::GetCurrentWindow()->InnerClipRect.Min.y;
+    int first = minY > y0 ? rows.Find(minY - y0) : 0;
+    if (first >= rows.Size()) {
+        //everything scrolled out
+        ClipperStack::SeekY(y0 + rows.Offset(rows.Size()), rows.Size());
+        --cs.depth;
+        return std::numeric_limits<int>::max();
+    }
+    entry.itemY = y0 + rows.Offset(first);
+    ClipperStack::SeekY(entry.itemY, first);
+    return first;
+}
+
 inline void PushInvisibleScrollbar()
 {
     ImVec4 clr = ImGui::GetStyleColorVec4(ImGuiCol_ScrollbarBg);
@@ -507,23 +882,174 @@ inline void PopIgnoreWindowPadding(const IgnoreWindowPaddingData& data)
     ImGui::PopClipRect();
 }
 
+//state of drag helpers kept per window so drags in different windows
+//or contexts don't interfere
+//entries of windows which weren't seen for PruneFrames are dropped and
+//a context's entries are dropped on its shutdown
+template <class T>
+T& WindowState(ImGuiWindow* window)
+{
+    const int PruneFrames = 60;
+
+    struct Entry
+    {
+        T state;
+        int frame;
+    };
+    struct Store
+    {
+        std::unordered_map<ImGuiID, Entry> states;
+        int pruneFrame = 0;
+    };
+    static std::unordered_map<ImGuiContext*, Store> stores;
+    
+    ImGuiContext* ctx = ImGui::GetCurrentContext();
+    auto it = stores.find(ctx);
+    if (it == stores.end())
+    {
+        it = stores.emplace(ctx, Store()).first;
+        ImGuiContextHook hook;
+        hook.Type = ImGuiContextHookType_Shutdown;
+        hook.Callback = [](ImGuiContext* c, ImGuiContextHook*) {
+            stores.erase(c);
+        };
+        ImGui::AddContextHook(ctx, &hook);
+    }
+    Store& store = it->second;
+    int frame = ImGui::GetFrameCount();
+    if (frame - store.pruneFrame >= PruneFrames)
+    {
+        store.pruneFrame = frame;
+        for (auto jt = store.states.begin(); jt != store.states.end(); )
+        {
+            if (frame - jt->second.frame >= PruneFrames)
+                jt = store.states.erase(jt);
+            else
+                ++jt;
+        }
+    }
+    Entry& entry = store.states[window->ID];
+    entry.frame = frame;
+    return entry.state;
+}
+
+//estimates mouse velocity in pixels/s from recent frames
+//so it doesn't depend on frame rate
+struct DragVelocity
+{
+    static constexpr int N = 8;
+    static constexpr float Period = 0.1f;
+
+    void Reset()
+    {
+        count = 0;
+    }
+    void Add(const ImVec2& delta, float dt)
+    {
+        samples[head] = { delta, dt };
+        head = (head + 1) % N;
+        if (count < N)
+            ++count;
+    }
+    ImVec2 Get() const
+    {
+        ImVec2 d{ 0, 0 };
+        float t = 0;
+        for (int k = 0; k < count && t < Period; ++k) {
+            const auto& smp = samples[(head - 1 - k + N) % N];
+            d.x += smp.delta.x;
+            d.y += smp.delta.y;
+            t += smp.dt;
+        }
+        if (t <= 0)
+            return { 0, 0 };
+        return { d.x / t, d.y / t };
+    }
+
+private:
+    struct Sample 
+    {
+        ImVec2 delta;
+        float dt;
+    };
+    Sample samples[N];
+    int head = 0;
+    int count = 0;
+};
+
+inline void DrawScrollbars(ImGuiWindow* window)
+{
+    bool tmp = window->SkipItems;
+    window->SkipItems = false;
+    ImGui::PushClipRect(window->Rect().Min, window->Rect().Max, false);
+    ImVec4 clr = ImGui::GetStyleColorVec4(ImGuiCol_ScrollbarGrab);
+    ImGui::PushStyleColor(ImGuiCol_ScrollbarGrab, { clr.x, clr.y, clr.z, 1 });
+    if (window->ScrollbarX)
+        ImGui::Scrollbar(ImGuiAxis_X);
+    if (window->ScrollbarY)
+        ImGui::Scrollbar(ImGuiAxis_Y);
+    ImGui::PopStyleColor();
+    ImGui::PopClipRect();
+    window->SkipItems = tmp;
+}
+
 //optionally draws scrollbars so they can be kept hidden when no scrolling occurs
+//with kinetic set scrolling continues after release and slows down over time
 //returns:
 //0 - nothing happening or scrolling continues
 //1 - scrolling started
 //2 - scrolling ended
-inline int ScrollWhenDragging(bool drawScrollbars)
+inline int ScrollWhenDragging(bool drawScrollbars, bool kinetic = false)
 {
-    static int dragState = 0;
+    const float KineticDecay = 0.325f; //velocity time constant in seconds
+    const float KineticMinSpeed = 20.f;
+    
+    struct State
+    {
+        int dragState = 0;
+        DragVelocity velocity;
+        ImVec2 speed{ 0, 0 };
+    };
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    State& state = WindowState<State>(window);
+    float dt = ImGui::GetIO().DeltaTime;
+
+    if (state.speed.x || state.speed.y)
+    {
+        if (ImGui::IsMouseDown(ImGuiMouseButton_Left) && ImGui::IsWindowHovered(ImGuiHoveredFlags_ChildWindows))
+            state.speed = { 0, 0 };
+        else
+        {
+            //stop at the scroll limits
+            if ((state.speed.x > 0 && window->Scroll.x <= 0) ||
+                (state.speed.x < 0 && window->Scroll.x >= window->ScrollMax.x))
+                state.speed.x = 0;
+            if ((state.speed.y > 0 && window->Scroll.y <= 0) ||
+                (state.speed.y < 0 && window->Scroll.y >= window->ScrollMax.y))
+                state.speed.y = 0;
+            if (state.speed.x)
+                ImGui::SetScrollX(window, window->Scroll.x - state.speed.x * dt);
+            if (state.speed.y)
+                ImGui::SetScrollY(window, window->Scroll.y - state.speed.y * dt);
+            float decay = std::exp(-dt / KineticDecay);
+            state.speed.x *= decay;
+            state.speed.y *= decay;
+            if (std::abs(state.speed.x) < KineticMinSpeed && std::abs(state.speed.y) < KineticMinSpeed)
+                state.speed = { 0, 0 };
+            if (drawScrollbars)
+                DrawScrollbars(window);
+        }
+    }
 
     if (!ImGui::IsWindowFocused())
         return 0;
 
     if (ImGui::IsMouseDragging(ImGuiMouseButton_Left))
     {
-        int ret = !dragState ? 1 : 0;
-        dragState = 1;
-        ImGuiWindow *window = ImGui::GetCurrentWindow();
+        int ret = !state.dragState ? 1 : 0;
+        if (!state.dragState)
+            state.velocity.Reset();
+        state.dragState = 1;
         ImGui::GetCurrentContext()->NavDisableMouseHover = true;
         ImVec2 delta = ImGui::GetMouseDragDelta(ImGuiMouseButton_Left);
         if (delta.x)
@@ -531,28 +1057,18 @@ inline int ScrollWhenDragging(bool drawScrollbars)
         if (delta.y)
             ImGui::SetScrollY(window, window->Scroll.y - delta.y);
         ImGui::ResetMouseDragDelta(ImGuiMouseButton_Left);
+        state.velocity.Add(delta, dt);
 
         //scrollbars were made invisible, draw them again
         if (drawScrollbars)
-        {
-            bool tmp = window->SkipItems;
-            window->SkipItems = false;
-            ImGui::PushClipRect(window->Rect().Min, window->Rect().Max, false);
-            ImVec4 clr = ImGui::GetStyleColorVec4(ImGuiCol_ScrollbarGrab);
-            ImGui::PushStyleColor(ImGuiCol_ScrollbarGrab, { clr.x, clr.y, clr.z, 1 });
-            if (window->ScrollbarX)
-                ImGui::Scrollbar(ImGuiAxis_X);
-            if (window->ScrollbarY)
-                ImGui::Scrollbar(ImGuiAxis_Y);
-            ImGui::PopStyleColor();
-            ImGui::PopClipRect();
-            window->SkipItems = tmp;
-        }
+            DrawScrollbars(window);
         return ret;
     }
-    else if (dragState == 1)
+    else if (state.dragState == 1)
     {
-        dragState = 0;
+        state.dragState = 0;
+        if (kinetic)
+            state.speed = state.velocity.Get();
         ImGui::GetCurrentContext()->NavDisableMouseHover = false;
         ImGui::GetIO().MousePos = { -FLT_MAX, -FLT_MAX }; //ignore mouse release event, buttons won't get pushed
         return 2;
@@ -570,24 +1086,32 @@ inline int ScrollWhenDragging(bool drawScrollbars)
 // 2 - todo: maximize up/down popup
 inline int MoveWhenDragging(ImGuiDir dir, ImVec2& pos, float& dimBgRatio)
 {
-    static int dragState = 0;
-    static ImVec2 mousePos[3];
-    static ImVec2 startPos, lastPos;
-    static float lastDim;
+    const float CloseSpeed = 300; //pixels/s
+    
+    struct State
+    {
+        int dragState = 0;
+        DragVelocity velocity;
+        ImVec2 lastMouse;
+        ImVec2 startPos, lastPos;
+        float lastDim;
+    };
+    State& state = WindowState<State>(ImGui::GetCurrentWindow());
 
     if (ImGui::IsWindowFocused())
     {
         if (ImGui::IsMouseDragging(ImGuiMouseButton_Left))
         {
-            if (!dragState)
+            if (!state.dragState)
             {
-                startPos = pos;
-                mousePos[1] = mousePos[2] = ImGui::GetMousePos();
+                state.startPos = pos;
+                state.lastMouse = ImGui::GetMousePos();
+                state.velocity.Reset();
             }
-            dragState = 1;
-            mousePos[0] = mousePos[1];
-            mousePos[1] = mousePos[2];
-            mousePos[2] = ImGui::GetMousePos();
+            state.dragState = 1;
+            ImVec2 mouse = ImGui::GetMousePos();
+            state.velocity.Add({ mouse.x - state.lastMouse.x, mouse.y - state.lastMouse.y }, ImGui::GetIO().DeltaTime);
+            state.lastMouse = mouse;
             ImGuiWindow *window = ImGui::GetCurrentWindow();
             ImGui::GetCurrentContext()->NavDisableMouseHover = true;
 
@@ -596,19 +1120,19 @@ inline int MoveWhenDragging(ImGuiDir dir, ImVec2& pos, float& dimBgRatio)
             //was externally modified with Animator
             //ImGui::ResetMouseDragDelta(ImGuiMouseButton_Left);
             if (dir == ImGuiDir_Left) {
-                pos.x = startPos.x + delta.x;
+                pos.x = state.startPos.x + delta.x;
                 dimBgRatio = (window->Size.x + pos.x) / window->Size.x;
             }
             else if (dir == ImGuiDir_Right) {
-                pos.x = startPos.x - delta.x;
+                pos.x = state.startPos.x - delta.x;
                 dimBgRatio = (window->Size.x + pos.x) / window->Size.x;
             }
             else if (dir == ImGuiDir_Up) {
-                pos.y = startPos.y + delta.y;
+                pos.y = state.startPos.y + delta.y;
                 dimBgRatio = (window->Size.y + pos.y) / window->Size.y;
             }
             else if (dir == ImGuiDir_Down) {
-                pos.y = startPos.y - delta.y;
+                pos.y = state.startPos.y - delta.y;
                 dimBgRatio = (window->Size.y + pos.y) / window->Size.y;
             }
             if (pos.x > 0) {
@@ -619,28 +1143,27 @@ inline int MoveWhenDragging(ImGuiDir dir, ImVec2& pos, float& dimBgRatio)
                 pos.y = 0;
                 dimBgRatio = 1;
             }
-            lastPos = pos;
-            lastDim = dimBgRatio;
+            state.lastPos = pos;
+            state.lastDim = dimBgRatio;
         }
-        else if (dragState == 1)
+        else if (state.dragState == 1)
         {
             //apply lastPos because position could be rewritten by Animator but the real value
             //needs to be taken for next closing animation
-            pos = lastPos;
-            dimBgRatio = lastDim;
-            dragState = 0;
+            pos = state.lastPos;
+            dimBgRatio = state.lastDim;
+            state.dragState = 0;
             ImGui::GetCurrentContext()->NavDisableMouseHover = false;
             ImGui::GetIO().MousePos = { -FLT_MAX, -FLT_MAX }; //ignore mouse release event, buttons won't get pushed
 
-            float spx = (mousePos[2].x - mousePos[0].x) / 2;
-            float spy = (mousePos[2].y - mousePos[0].y) / 2;
-            if (dir == ImGuiDir_Left && spx < -5)
+            ImVec2 speed = state.velocity.Get();
+            if (dir == ImGuiDir_Left && speed.x < -CloseSpeed)
                 return 0;
-            if (dir == ImGuiDir_Right && spx > 5)
+            if (dir == ImGuiDir_Right && speed.x > CloseSpeed)
                 return 0;
-            if (dir == ImGuiDir_Up && spy < -5)
+            if (dir == ImGuiDir_Up && speed.y < -CloseSpeed)
                 return 0;
-            if (dir == ImGuiDir_Down && spy > 5)
+            if (dir == ImGuiDir_Down && speed.y > CloseSpeed)
                 return 0;
         }
     }
@@ -742,304 +1265,85 @@ inline void RenderFilledWindowCorners(ImDrawFlags fl)
     ImGui::PopClipRect();
 }
 
-inline std::string Format(std::string_view fmt)
-{
-    return std::string(fmt);
-}
-
-template <class A1, class... A>
-std::string Format(std::string_view fmt, A1&& arg, A&&... args)
+//name->font lookup used by GetFontByName, one table per font atlas
+//Tables are rebuilt when the epoch changes or fonts were added. LoadStyle and
+//LoadStyleCache bump the epoch, call Invalidate after clearing fonts of an atlas
+//by other means and Remove before destroying it
+class FontTable
 {
-#ifdef IMRAD_WITH_FMT
-    return fmt::format(fmt, std::forward<A1>(arg), std::forward<A>(args)...);
-#else
-    //todo
-    std::string s;
-    for (size_t i = 0; i < fmt.size(); ++i)
-    {
-        if (fmt[i] == '{') {
-            if (i + 1 == fmt.size())
-                break;
-            if (fmt[i + 1] == '{') {
-                s += '{';
-                ++i;
-            }
-            else {
-                auto j = fmt.find('}', i + 1);
-                if (j == std::string::npos)
-                    break;
-                if constexpr (std::is_same_v<std::decay_t<A1>, std::string>)
-                    s += arg;
-                else if constexpr (std::is_same_v<std::decay_t<A1>, const char*> || 
-                                    std::is_same_v<std::decay_t<A1>, char*>)
-                    s += arg;
-                else if constexpr (std::is_same_v<std::decay_t<A1>, char>)
-                    s += arg;
-                else
-                    s += std::to_string(arg);
-                return s + Format(fmt.substr(j + 1), args...);
-            }
-        }
-        else
-            s += fmt[i];
+public:
+    static void Invalidate()
+    {
+        ++Epoch();
     }
-    return s;
-#endif
-}
-
-#if (defined (IMRAD_WITH_GLFW) || defined(ANDROID)) && defined(IMRAD_WITH_STB)
-// Simple helper function to load an image into a OpenGL texture with common settings
-// https://github.com/ocornut/imgui/wiki/Image-Loading-and-Displaying-Examples
-inline Texture LoadTextureFromFile(
-    std::string_view filename,
-    int minFilter = GL_LINEAR, 
-    int magFilter = GL_LINEAR, 
-    int wrapS = GL_CLAMP_TO_EDGE, // This is required on WebGL for non power-of-two textures
-    int wrapT = GL_CLAMP_TO_EDGE // Same
-) {
-    // Load from file
-    Texture tex;
-    unsigned char* image_data = nullptr;
-#ifdef ANDROID
-    unsigned char* buffer;
-    int len = GetAssetData(filename.c_str(), &buffer);
-    image_data = stbi_load_from_memory(buffer, len, &tex.w, &tex.h, NULL, 4);
-#else
-    std::string tmp(filename);
-    image_data = stbi_load(tmp.c_str(), &tex.w, &tex.h, NULL, 4);
-#endif
-    if (image_data == NULL)
-        return {};
-
-    // Create a OpenGL texture identifier
-    GLuint image_texture;
-    glGenTextures(1, &image_texture);
-    tex.id = (ImTextureID)(intptr_t)image_texture;
-    glBindTexture(GL_TEXTURE_2D, image_texture);
-
-    // Setup filtering parameters for display
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapS); 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapT); 
-
-    // Upload pixels into texture
-#if defined(GL_UNPACK_ROW_LENGTH) && !defined(__EMSCRIPTEN__)
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-#endif
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex.w, tex.h, 0, GL_RGBA, GL_UNSIGNED_BYTE, image_data);
-    stbi_image_free(image_data);
-
-    return tex;
-}
-#else
-Texture LoadTextureFromFile(std::string_view filename);
-#endif
-
-//For debugging pruposes
-inline void SaveStyle(std::string_view fname_, const ImGuiStyle* src = nullptr, const std::map<std::string, std::string>& extra = {})
-{
-    const ImGuiStyle* style = src ? src : &ImGui::GetStyle();
-    std::string fname(fname_.begin(), fname_.end());
-    std::ofstream fout(fname);
-    if (!fout)
-        throw std::runtime_error("can't write '" + fname + "'");
-    
-    fout << "[colors]\n";
-    for (int i = 0; i < ImGuiCol_COUNT; ++i) {
-        fout << ImGui::GetStyleColorName(i) << " = ";
-        const auto& clr = style->Colors[i];
-        fout << int(clr.x * 255) << " " << int(clr.y * 255) << " " 
-            << int(clr.z * 255) << " " << int(clr.w * 255) << "\n";
+    static unsigned GetEpoch()
+    {
+        return Epoch();
     }
-
-    fout << "\n[variables]\n";
-#define WRITE_FLT(a) fout << #a " = " << style->a << "\n"
-#define WRITE_VEC(a) fout << #a " = " << style->a.x << " " << style->a.y << "\n"
-    
-    WRITE_FLT(Alpha);
-    WRITE_FLT(DisabledAlpha);
-    WRITE_VEC(WindowPadding);
-    WRITE_FLT(WindowRounding);
-    WRITE_FLT(WindowBorderSize);
-    WRITE_VEC(WindowMinSize);
-    WRITE_VEC(WindowTitleAlign);
-    WRITE_FLT(ChildRounding);
-    WRITE_FLT(ChildBorderSize);
-    WRITE_FLT(PopupRounding);
-    WRITE_FLT(PopupBorderSize);
-    WRITE_VEC(FramePadding);
-    WRITE_FLT(FrameRounding);
-    WRITE_FLT(FrameBorderSize);
-    WRITE_VEC(ItemSpacing);
-    WRITE_VEC(ItemInnerSpacing);
-    WRITE_VEC(CellPadding);
-    WRITE_FLT(IndentSpacing);
-    WRITE_FLT(ScrollbarSize);
-    WRITE_FLT(ScrollbarRounding);
-    WRITE_FLT(TabRounding);
-    WRITE_FLT(TabBorderSize);
-#undef WRITE_FLT
-#undef WRITE_VEC
-
-    fout << "\n[fonts]\n";
-    fout << "Default = \"Roboto-Medium.ttf\" size 20\n";
-    
-    std::string lastSection;
-    for (const auto& kv : extra)
-    {
-        size_t i = kv.first.find_last_of('.');
-        if (i == std::string::npos)
-            continue;
-        if (kv.first.substr(0, i) != lastSection) {
-            lastSection = kv.first.substr(0, i);
-            fout << "\n[" << lastSection << "]\n";
+    static void Rebuild(ImFontAtlas* atlas)
+    {
+        Table& t = Tables()[atlas];
+        t.fonts.clear();
+        t.epoch = Epoch();
+        t.configCount = atlas->ConfigData.Size;
+        for (const auto& cfg : atlas->ConfigData) {
+            if (cfg.MergeMode || FindIn(t, cfg.Name))
+                continue; //first font with the same name wins like in the linear scan
+            ImGuiID id = ImHashData(cfg.Name, strlen(cfg.Name));
+            t.fonts.emplace(id, Entry{ cfg.Name, cfg.DstFont });
         }
-        fout << kv.first.substr(i + 1) << " = " << kv.second << "\n";
     }
-}
-
-//This function can be used in your code to load style and fonts from the INI file
-//It is also used by ImRAD when switching themes
-inline void LoadStyle(std::string_view fname, float fontScaling = 1, ImGuiStyle* dst = nullptr, std::map<std::string, ImFont*>* fontMap = nullptr, std::map<std::string, std::string>* extra = nullptr)
-{
-    ImGuiStyle* style = dst ? dst : &ImGui::GetStyle();
-    *style = ImGuiStyle();
-    auto& io = ImGui::GetIO();
-
-    std::string parentPath(fname);
-    size_t ix = parentPath.find_last_of("/\\");
-    if (ix != std::string::npos)
-        parentPath.resize(ix + 1);
-
-    std::ifstream fin(std::string(fname.begin(), fname.end()));
-    if (!fin)
-        throw std::runtime_error("Can't read " + std::string(fname));
-    std::string line;
-    std::string cat;
-    int lastClr = -1;
-    std::string lastFont;
-    while (std::getline(fin, line)) 
-    {
-        if (line.empty() || line[0] == ';' || line[0] == '#')
-            continue;
-        else if (line[0] == '[' && line.back() == ']')
-            cat = line.substr(1, line.size() - 2);
-        else
+    static void Remove(ImFontAtlas* atlas)
+    {
+        Tables().erase(atlas);
+        Invalidate();
+    }
+    static ImFont* Find(ImFontAtlas* atlas, std::string_view name)
+    {
+        auto& tables = Tables();
+        auto tit = tables.find(atlas);
+        if (tit == tables.end() || 
+            tit->second.epoch != Epoch() ||
+            tit->second.configCount != atlas->ConfigData.Size)
         {
-            size_t i1 = line.find_first_not_of("=\t ", 0);
-            size_t i2 = line.find_first_of("=\t ", i1);
-            if (i1 == std::string::npos || i2 == std::string::npos)
-                continue;
-            std::string key = line.substr(i1, i2 - i1);
-            i1 = line.find_first_not_of("=\t ", i2);
-            std::istringstream is(line.substr(i1));
-            
-            if (cat == "colors")
-            {
-                for (int i = lastClr + 1; i != lastClr; i = (i + 1) % ImGuiCol_COUNT)
-                    if (key == ImGui::GetStyleColorName(i)) {
-                        lastClr = i;
-                        int r, g, b, a;
-                        is >> r >> g >> b >> a;
-                        style->Colors[i].x = r / 255.f;
-                        style->Colors[i].y = g / 255.f;
-                        style->Colors[i].z = b / 255.f;
-                        style->Colors[i].w = a / 255.f;
-                        break;
-                    }
-            }
-            else if (cat == "variables")
-            {
-#define READ_FLT(a) if (key == #a) is >> style->a;
-#define READ_VEC(a) if (key == #a) is >> style->a.x >> style->a.y;
-                
-                READ_FLT(Alpha);
-                READ_FLT(DisabledAlpha);
-                READ_VEC(WindowPadding);
-                READ_FLT(WindowRounding);
-                READ_FLT(WindowBorderSize);
-                READ_VEC(WindowMinSize);
-                READ_VEC(WindowTitleAlign);
-                READ_FLT(ChildRounding);
-                READ_FLT(ChildBorderSize);
-                READ_FLT(PopupRounding);
-                READ_FLT(PopupBorderSize);
-                READ_VEC(FramePadding);
-                READ_FLT(FrameRounding);
-                READ_FLT(FrameBorderSize);
-                READ_VEC(ItemSpacing);
-                READ_VEC(ItemInnerSpacing);
-                READ_VEC(CellPadding);
-                READ_FLT(IndentSpacing);
-                READ_FLT(ScrollbarSize);
-                READ_FLT(ScrollbarRounding);
-                READ_FLT(TabRounding);
-                READ_FLT(TabBorderSize);
-#undef READ_FLT
-#undef READ_VEC
-            }
-            else if (cat == "fonts")
-            {
-                std::string fname, path;
-                float size = 20;
-                ImVec2 goffset;
-                bool hasRange = false;
-                static std::vector<std::unique_ptr<ImWchar[]>> rngs;
-
-                is >> std::quoted(fname);
-                path = fname;
-                bool isAbsolute = path.size() >= 2 && (path[0] == '/' || path[1] == ':');
-                if (!isAbsolute)
-                    path = parentPath + path;
-                std::string tmp;
-                while (is >> tmp)
-                {
-                    if (tmp == "size")
-                        is >> size;
-                    else if (tmp == "range") {
-                        hasRange = true;
-                        //needs to outlive this function
-                        rngs.push_back(std::unique_ptr<ImWchar[]>(new ImWchar[3]));
-                        is >> rngs.back()[0] >> rngs.back()[1];
-                        rngs.back()[2] = 0;
-                    }
-                    else if (tmp == "goffset") {
-                        is >> goffset.x >> goffset.y;
-                    }
-                }
-
-                ImFontConfig cfg;
-                strncpy(cfg.Name, key.c_str(), sizeof(cfg.Name));
-                cfg.Name[sizeof(cfg.Name) - 1] = '\0';
-                cfg.MergeMode = key == lastFont;
-                cfg.GlyphRanges = hasRange ? rngs.back().get() : nullptr;
-                cfg.GlyphOffset = { goffset.x * fontScaling, goffset.y * fontScaling };
-#ifdef ANDROID
-                void* font_data;
-                int font_data_size = GetAssetData(fname.c_str(), &font_data);
-                ImFont* fnt = io.Fonts->AddFontFromMemoryTTF(font_data, font_data_size, size * fontScaling);
-#else
-                if (!std::ifstream(path))
-                    throw std::runtime_error("Can't read '" + path + "'");
-                ImFont* fnt = io.Fonts->AddFontFromFileTTF(path.c_str(), size * fontScaling, &cfg);
-#endif
-                if (!fnt)
-                    throw std::runtime_error("Can't load " + path);
-                if (!cfg.MergeMode && fontMap)
-                    (*fontMap)[lastFont == "" ? "" : key] = fnt;
-            
-                lastFont = key;
-            }
-            else if (extra)
-            {
-                (*extra)[cat + "." + key] = is.str();
-            }
+            Rebuild(atlas);
+            tit = tables.find(atlas);
         }
+        return FindIn(tit->second, name);
     }
-    if (fontMap && !(*fontMap).count(""))
-        (*fontMap)[""] = io.Fonts->AddFontDefault();
-}
+
+private:
+    struct Entry
+    {
+        std::string name;
+        ImFont* font;
+    };
+    struct Table
+    {
+        unsigned epoch = 0;
+        int configCount = -1;
+        std::unordered_multimap<ImGuiID, Entry> fonts;
+    };
+    static ImFont* FindIn(const Table& t, std::string_view name)
+    {
+        //names are compared as well, different names can share the hash
+        auto range = t.fonts.equal_range(ImHashData(name.data(), name.size()));
+        for (auto it = range.first; it != range.second; ++it)
+            if (it->second.name == name)
+                return it->second.font;
+        return nullptr;
+    }
+    static std::unordered_map<ImFontAtlas*, Table>& Tables()
+    {
+        static std::unordered_map<ImFontAtlas*, Table> tables;
+        return tables;
+    }
+    static unsigned& Epoch()
+    {
+        static unsigned epoch = 0;
+        return epoch;
+    }
+};
 
 //This function will be called from the generated code when alternate font is used
 inline ImFont* GetFontByName(std::string_view name)
@@ -1047,14 +1351,31 @@ inline ImFont* GetFontByName(std::string_view name)
     if (name == "")
         return ImGui::GetDefaultFont();
 
-    const auto& io = ImGui::GetIO();
-    for (const auto& cfg : io.Fonts->ConfigData) {
-        if (cfg.MergeMode)
-            continue;
-        if (name == cfg.Name)
-            return cfg.DstFont;
-    }
-    return nullptr;
+    return FontTable::Find(ImGui::GetIO().Fonts, name);
 }
 
+//GetFontByName result kept by generated code, looked up again only when
+//io.Fonts or the FontTable epoch changed or fonts were added
+class FontHandle
+{
+public:
+    ImFont* Get(std::string_view name)
+    {
+        ImFontAtlas* fonts = ImGui::GetIO().Fonts;
+        if (fonts != atlas || epoch != FontTable::GetEpoch() || count != fonts->ConfigData.Size) {
+            font = GetFontByName(name);
+            atlas = fonts;
+            epoch = FontTable::GetEpoch();
+            count = fonts->ConfigData.Size;
+        }
+        return font;
+    }
+
+private:
+    ImFontAtlas* atlas = nullptr;
+    unsigned epoch = 0;
+    int count = -1;
+    ImFont* font = nullptr;
+};
+
 }
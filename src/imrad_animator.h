@@ -0,0 +1,162 @@
+#pragma once
+#include "imrad.h"
+
+namespace ImRad {
+
+//easing curves for Animator, x and result go from 0 to 1
+struct EaseLinear
+{
+    static float Apply(float x) { return x; }
+};
+
+struct EaseOutQuad
+{
+    static float Apply(float x) { return 1 - (1 - x) * (1 - x); }
+};
+
+struct EaseOutCubic
+{
+    static float Apply(float x) { float t = 1 - x; return 1 - t * t * t; }
+};
+
+struct EaseInOutQuad
+{
+    static float Apply(float x) { return x < 0.5f ? 2 * x * x : 1 - 2 * (1 - x) * (1 - x); }
+};
+
+struct EaseOutBack
+{
+    static float Apply(float x) { float t = x - 1; return 1 + 2.70158f * t * t * t + 1.70158f * t * t; }
+};
+
+//Active vars are kept in a dense array, each animated pointer owns a slot
+//found through a hash map. Slots are reused so there are no allocations
+//once all animated vars were started
+template <class Ease = EaseOutQuad>
+struct BasicAnimator 
+{
+    //todo: configure
+    static inline const float DurOpenPopup = 0.4f; 
+    static inline const float DurClosePopup = 0.3f;
+
+    void StartAlways(float *v, float s, float e, float dur) 
+    {
+        Start(v, s, e, dur, false);
+    }
+    void StartOnce(float *v, float s, float e, float dur) 
+    {
+        Start(v, s, e, dur, true);
+    }
+    //stops animating v, it jumps to the end value when finish is set
+    void Cancel(float* v, bool finish = false)
+    {
+        auto it = slotMap.find(v);
+        if (it == slotMap.end() || slots[it->second].active < 0)
+            return;
+        if (finish)
+            *v = slots[it->second].end;
+        Deactivate(it->second);
+    }
+    void CancelAll()
+    {
+        while (active.size())
+            Deactivate(active.back());
+    }
+    bool IsDone() const 
+    {
+        return !busy;
+    }
+    //to be called from withing Begin
+    void Tick() 
+    {
+        wsize = ImGui::GetCurrentWindow()->Size; //cache actual windows size
+        float dt = ImGui::GetIO().DeltaTime;
+        //iterate backwards so finished vars can be swapped out
+        for (size_t k = active.size(); k-- > 0; ) 
+        {
+            int slot = active[k];
+            auto& var = slots[slot];
+            var.time += dt;
+            float x = var.duration > 0 ? var.time / var.duration : 1.f;
+            if (x > 1)
+                x = 1.f;
+            float y = Ease::Apply(x);
+            *var.var = var.start + y * (var.end - var.start);
+            if (var.oneShot) {
+                if (x > 0.99f)
+                    Deactivate(slot);
+            }
+            else {
+                busy -= IsBusy(var);
+                var.done = std::abs(*var.var - var.end) <= 0.01f * std::abs(var.end - var.start);
+                busy += IsBusy(var);
+            }
+        }
+    }
+    ImVec2 GetWindowSize() const 
+    {
+        return wsize;
+    }
+
+private:
+    struct Var 
+    {
+        float time = 0;
+        float* var = nullptr;
+        float start = 0, end = 0;
+        float duration = 0;
+        bool oneShot = false;
+        bool done = false;
+        int active = -1; //index into active or -1
+    };
+    static bool IsBusy(const Var& var)
+    {
+        return var.active >= 0 && (var.oneShot || !var.done);
+    }
+    void Start(float* v, float s, float e, float dur, bool oneShot)
+    {
+        auto it = slotMap.find(v);
+        int slot;
+        if (it != slotMap.end())
+            slot = it->second;
+        else {
+            slot = (int)slots.size();
+            slots.emplace_back();
+            slotMap.emplace(v, slot);
+        }
+        auto& var = slots[slot];
+        busy -= IsBusy(var);
+        if (var.active < 0) {
+            var.active = (int)active.size();
+            active.push_back(slot);
+        }
+        var.time = 0;
+        var.var = v;
+        var.start = s;
+        var.end = e;
+        var.duration = dur;
+        var.oneShot = oneShot;
+        var.done = s == e;
+        busy += IsBusy(var);
+    }
+    void Deactivate(int slot)
+    {
+        auto& var = slots[slot];
+        busy -= IsBusy(var);
+        int last = active.back();
+        active[var.active] = last;
+        slots[last].active = var.active;
+        active.pop_back();
+        var.active = -1;
+    }
+
+    std::vector<Var> slots;
+    std::unordered_map<float*, int> slotMap;
+    std::vector<int> active;
+    int busy = 0;
+    ImVec2 wsize{ 0, 0 };
+};
+
+using Animator = BasicAnimator<>;
+
+}
@@ -0,0 +1,547 @@
+#pragma once
+#include "imrad.h"
+#include <string_view>
+#include <type_traits>
+
+#ifdef IMRAD_WITH_FMT
+#include <fmt/format.h>
+#else
+#include <charconv> //for Format
+#include <cstdio>
+#endif
+
+#ifdef __cpp_consteval
+#define IMRAD_CONSTEVAL consteval
+#else
+#define IMRAD_CONSTEVAL constexpr
+#endif
+
+//wraps format literals in generated code so they are parsed at compile time
+//C++17 only guarantees that for a constexpr variable initializer
+#if defined(IMRAD_WITH_FMT) || defined(__cpp_consteval)
+#define IMRAD_FORMAT(s) s
+#else
+#define IMRAD_FORMAT(s) ([]() -> const ImRad::FormatString& { static constexpr ImRad::FormatString f = s; return f; }())
+#endif
+
+namespace ImRad {
+
+//types which FormatArg can hold, fmt backend supports other types too
+template <class T, class U = std::decay_t<T>>
+inline constexpr bool IsFormatArg = std::is_arithmetic_v<U> || std::is_enum_v<U> ||
+                                    std::is_convertible_v<const U&, std::string_view>;
+
+//type erased Format argument, strings are referenced not copied
+struct FormatArg
+{
+    enum Kind { Int, UInt, Float, Double, Bool, Char, Str };
+    Kind kind = Int;
+    union {
+        long long i = 0;
+        unsigned long long u;
+        float f;
+        double d;
+        bool b;
+        char c;
+    };
+    std::string_view s;
+
+    FormatArg() {}
+
+    template <class T>
+    FormatArg(const T& v)
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>)
+            kind = Bool, b = v;
+        else if constexpr (std::is_same_v<U, char>)
+            kind = Char, c = v;
+        else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            kind = Str, s = v;
+        else if constexpr (std::is_enum_v<U>)
+            kind = Int, i = (long long)v;
+        else if constexpr (std::is_same_v<U, float>)
+            kind = Float, f = v;
+        else if constexpr (std::is_floating_point_v<U>)
+            kind = Double, d = (double)v;
+        else if constexpr (std::is_signed_v<U>)
+            kind = Int, i = v;
+        else {
+            static_assert(std::is_unsigned_v<U>, "unsupported Format argument");
+            kind = UInt, u = v;
+        }
+    }
+};
+
+inline std::string Format(std::string_view fmt)
+{
+    return std::string(fmt);
+}
+
+#ifdef IMRAD_WITH_FMT
+template <class A1, class... A>
+std::string Format(std::string_view fmt, A1&& arg, A&&... args)
+{
+    return fmt::format(fmt, std::forward<A1>(arg), std::forward<A>(args)...);
+}
+#else
+//Format pattern split into literal segments and replacement fields. When constructed
+//from a string literal it's parsed at compile time with C++20 consteval. Under C++17
+//the constructor is only constexpr so a temporary pattern like Format("{}", x) is
+//parsed at runtime on every call. Generated code uses IMRAD_FORMAT("{}") instead
+//which initializes a static constexpr FormatString
+//Supported fields are {[index]} and {[index]:[[fill]align][+][0][width][.precision][type]}
+//Longer patterns continue parsing from rest, malformed ones are output verbatim from there
+struct FormatString
+{
+    static constexpr int MaxSegments = 8; //kept small as the whole object is passed per call
+
+    struct Segment
+    {
+        unsigned short begin = 0, end = 0; //literal text preceding the field, relative to str
+        bool field = false;
+        char fill = ' ';
+        char align = 0;
+        char type = 0;
+        bool plus = false;
+        bool zero = false;
+        unsigned short width = 0;
+        short prec = -1;
+        short arg = -1; //explicit argument index
+    };
+
+    const char* str = "";
+    size_t len = 0;
+    Segment segs[MaxSegments] = {};
+    int count = 0;
+    size_t rest = 0; //start of the trailing text
+    bool more = false; //trailing text wasn't parsed yet
+
+    template <size_t N>
+    IMRAD_CONSTEVAL FormatString(const char (&s)[N])
+        : str(s), len(std::char_traits<char>::length(s))
+    {
+        Parse();
+    }
+
+    template <class T, std::enable_if_t<!std::is_array_v<T> &&
+                                         std::is_convertible_v<const T&, std::string_view>, int> = 0>
+    FormatString(const T& s)
+    {
+        std::string_view sv(s);
+        str = sv.data();
+        len = sv.size();
+        Parse();
+    }
+
+private:
+    constexpr void Parse()
+    {
+        size_t b = 0, i = 0;
+        while (i < len)
+        {
+            if (count == MaxSegments || i >= 0xffff) {
+                more = true;
+                break;
+            }
+            char c = str[i];
+            if ((c == '{' || c == '}') && i + 1 < len && str[i + 1] == c) {
+                //keep the first brace of {{ or }}
+                segs[count].begin = (unsigned short)b;
+                segs[count].end = (unsigned short)(i + 1);
+                ++count;
+                i = b = i + 2;
+            }
+            else if (c == '{') {
+                Segment& seg = segs[count];
+                seg.begin = (unsigned short)b;
+                seg.end = (unsigned short)i;
+                seg.field = true;
+                size_t j = i + 1;
+                if (j < len && str[j] >= '0' && str[j] <= '9') {
+                    seg.arg = 0;
+                    for (; j < len && str[j] >= '0' && str[j] <= '9'; ++j)
+                        seg.arg = (short)std::min(seg.arg * 10 + (str[j] - '0'), 0x7fff);
+                }
+                if (j < len && str[j] == ':')
+                    j = ParseSpec(seg, j + 1);
+                if (j >= len || str[j] != '}') {
+                    seg = {};
+                    break;
+                }
+                ++count;
+                i = b = j + 1;
+            }
+            else
+                ++i;
+        }
+        rest = b;
+    }
+
+    constexpr size_t ParseSpec(Segment& seg, size_t j)
+    {
+        auto isAlign = [](char c) { return c == '<' || c == '>' || c == '^'; };
+        auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+        if (j + 1 < len && str[j] != '}' && isAlign(str[j + 1])) {
+            seg.fill = str[j];
+            seg.align = str[j + 1];
+            j += 2;
+        }
+        else if (j < len && isAlign(str[j]))
+            seg.align = str[j++];
+        if (j < len && str[j] == '+') {
+            seg.plus = true;
+            ++j;
+        }
+        if (j < len && str[j] == '0') {
+            seg.zero = true;
+            ++j;
+        }
+        for (; j < len && isDigit(str[j]); ++j)
+            seg.width = seg.width * 10 + (str[j] - '0');
+        if (j < len && str[j] == '.') {
+            seg.prec = 0;
+            for (++j; j < len && isDigit(str[j]); ++j)
+                seg.prec = seg.prec * 10 + (str[j] - '0');
+        }
+        if (j < len && str[j] != '}')
+            seg.type = str[j++];
+        return j;
+    }
+};
+
+inline void FormatArgTo(std::string& out, const FormatString::Segment& seg, const FormatArg& arg)
+{
+    char buf[64];
+    std::string tmp; //only for huge floats
+    std::string_view s;
+    bool num = false;
+    switch (arg.kind)
+    {
+    case FormatArg::Bool:
+        s = arg.b ? "true" : "false";
+        break;
+    case FormatArg::Char:
+        buf[0] = arg.c;
+        s = { buf, 1 };
+        break;
+    case FormatArg::Str:
+        s = arg.s;
+        if (seg.prec >= 0 && (size_t)seg.prec < s.size())
+            s = s.substr(0, seg.prec);
+        break;
+    case FormatArg::Int:
+    case FormatArg::UInt: {
+        num = true;
+        int base = seg.type == 'x' || seg.type == 'X' ? 16 : seg.type == 'o' ? 8 : seg.type == 'b' ? 2 : 10;
+        char* p = buf;
+        if (seg.plus && (arg.kind == FormatArg::UInt || arg.i >= 0))
+            *p++ = '+';
+        auto r = arg.kind == FormatArg::Int ?
+            std::to_chars(p, std::end(buf), arg.i, base) :
+            std::to_chars(p, std::end(buf), arg.u, base);
+        if (seg.type == 'X')
+            for (char* q = p; q < r.ptr; ++q)
+                if (*q >= 'a' && *q <= 'f')
+                    *q += 'A' - 'a';
+        s = { buf, size_t(r.ptr - buf) };
+        break;
+    }
+    case FormatArg::Float:
+    case FormatArg::Double: {
+        num = true;
+        double v = arg.kind == FormatArg::Float ? arg.f : arg.d;
+        bool typed = seg.type && std::string_view("fFeEgG").find(seg.type) != std::string_view::npos;
+#ifdef __cpp_lib_to_chars
+        if (!typed && seg.prec < 0) {
+            //shortest representation like fmt does
+            char* p = buf;
+            if (seg.plus && !std::signbit(v))
+                *p++ = '+';
+            auto r = arg.kind == FormatArg::Float ?
+                std::to_chars(p, std::end(buf), arg.f) :
+                std::to_chars(p, std::end(buf), arg.d);
+            s = { buf, size_t(r.ptr - buf) };
+            break;
+        }
+#endif
+        char spec[8] = "%";
+        char* p = spec + 1;
+        if (seg.plus)
+            *p++ = '+';
+        *p++ = '.';
+        *p++ = '*';
+        *p++ = typed ? seg.type : 'g';
+        *p = 0;
+        int prec = seg.prec >= 0 ? seg.prec : typed ? 6 : 17;
+        int n = std::snprintf(buf, sizeof(buf), spec, prec, v);
+        if (n < 0)
+            n = 0;
+        if ((size_t)n < sizeof(buf))
+            s = { buf, (size_t)n };
+        else {
+            tmp.resize(n + 1);
+            std::snprintf(tmp.data(), tmp.size(), spec, prec, v);
+            tmp.pop_back();
+            s = tmp;
+        }
+        break;
+    }
+    }
+
+    size_t w = 0;
+    if (seg.width) //count utf8 code points
+        for (char ch : s)
+            w += (ch & 0xc0) != 0x80;
+    if (w >= seg.width) {
+        out += s;
+        return;
+    }
+    size_t pad = seg.width - w;
+    if (seg.zero && num && !seg.align) {
+        size_t sign = s[0] == '+' || s[0] == '-';
+        out += s.substr(0, sign);
+        out.append(pad, '0');
+        out += s.substr(sign);
+        return;
+    }
+    char align = seg.align ? seg.align : num ? '>' : '<';
+    size_t left = align == '<' ? 0 : align == '^' ? pad / 2 : pad;
+    out.append(left, seg.fill);
+    out += s;
+    out.append(pad - left, seg.fill);
+}
+
+//n is the next automatically indexed argument
+inline void FormatTo(std::string& out, const FormatString& fmt, const FormatArg* args, size_t nargs, size_t n = 0)
+{
+    for (int i = 0; i < fmt.count; ++i)
+    {
+        const auto& seg = fmt.segs[i];
+        out.append(fmt.str + seg.begin, seg.end - seg.begin);
+        if (!seg.field)
+            continue;
+        size_t k = seg.arg >= 0 ? (size_t)seg.arg : n++;
+        if (k < nargs)
+            FormatArgTo(out, seg, args[k]);
+        else {
+            //no argument left, output the field as is
+            size_t next = i + 1 < fmt.count ? fmt.segs[i + 1].begin : fmt.rest;
+            out.append(fmt.str + seg.end, next - seg.end);
+        }
+    }
+    std::string_view tail(fmt.str + fmt.rest, fmt.len - fmt.rest);
+    if (fmt.more)
+        FormatTo(out, FormatString(tail), args, nargs, n);
+    else
+        out += tail;
+}
+
+//appends formatted text to out, reusing its capacity
+template <class... A>
+void FormatTo(std::string& out, const FormatString& fmt, A&&... args)
+{
+    const FormatArg fargs[] = { FormatArg(args)..., FormatArg() };
+    FormatTo(out, fmt, fargs, sizeof...(A));
+}
+
+template <class A1, class... A>
+std::string Format(const FormatString& fmt, A1&& arg, A&&... args)
+{
+    std::string out;
+    FormatTo(out, fmt, std::forward<A1>(arg), std::forward<A>(args)...);
+    return out;
+}
+#endif
+
+//Bump allocator for strings which live until the end of the current frame.
+//Memory is reclaimed in the NewFrame hook of each ImGui context it was used with.
+//When a frame needed more than one block they are merged so next frames don't allocate
+class FrameArena
+{
+public:
+    static const size_t BlockSize = 4096;
+
+    static FrameArena& Get()
+    {
+        static FrameArena arena;
+        return arena;
+    }
+
+    char* Alloc(size_t n)
+    {
+        Hook();
+        if (blocks.empty() || used + n > blocks.back().size) {
+            size_t sz = std::max(n, blocks.empty() ? BlockSize : 2 * blocks.back().size);
+            blocks.push_back({ std::make_unique<char[]>(sz), sz });
+            used = 0;
+        }
+        char* p = blocks.back().data.get() + used;
+        used += n;
+        return p;
+    }
+
+    const char* Store(std::string_view s)
+    {
+        char* p = Alloc(s.size() + 1);
+        std::memcpy(p, s.data(), s.size());
+        p[s.size()] = 0;
+        return p;
+    }
+
+    void Reset()
+    {
+        if (blocks.size() > 1) {
+            size_t total = 0;
+            for (const auto& b : blocks)
+                total += b.size;
+            blocks.clear();
+            blocks.push_back({ std::make_unique<char[]>(total), total });
+        }
+        used = 0;
+    }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    void Hook()
+    {
+        ImGuiContext* ctx = ImGui::GetCurrentContext();
+        if (!ctx || std::find(contexts.begin(), contexts.end(), ctx) != contexts.end())
+            return;
+        contexts.push_back(ctx);
+        ImGuiContextHook hook;
+        hook.UserData = this;
+        hook.Type = ImGuiContextHookType_NewFramePre;
+        hook.Callback = [](ImGuiContext*, ImGuiContextHook* h) {
+            ((FrameArena*)h->UserData)->Reset();
+        };
+        ImGui::AddContextHook(ctx, &hook);
+        hook.Type = ImGuiContextHookType_Shutdown;
+        hook.Callback = [](ImGuiContext* c, ImGuiContextHook* h) {
+            auto& ctxs = ((FrameArena*)h->UserData)->contexts;
+            ctxs.erase(std::remove(ctxs.begin(), ctxs.end(), c), ctxs.end());
+        };
+        ImGui::AddContextHook(ctx, &hook);
+    }
+
+    std::vector<Block> blocks;
+    size_t used = 0;
+    std::vector<ImGuiContext*> contexts;
+};
+
+//copy of s valid until the next frame
+inline const char* FrameString(std::string_view s)
+{
+    return FrameArena::Get().Store(s);
+}
+
+//formatted string valid until the next frame, used by generated code for bound labels
+#ifdef IMRAD_WITH_FMT
+template <class... A>
+const char* FrameFormat(std::string_view fmt, A&&... args)
+{
+    fmt::memory_buffer buf;
+    fmt::vformat_to(std::back_inserter(buf), fmt, fmt::make_format_args(args...));
+    return FrameString({ buf.data(), buf.size() });
+}
+#else
+template <class... A>
+const char* FrameFormat(const FormatString& fmt, A&&... args)
+{
+    thread_local std::string buf;
+    buf.clear();
+    FormatTo(buf, fmt, std::forward<A>(args)...);
+    return FrameString(buf);
+}
+#endif
+
+//Keeps formatted text together with a copy of the arguments and formats again 
+//only when they change. Generated code uses it for widgets with cached label
+class LabelCache
+{
+public:
+#ifdef IMRAD_WITH_FMT
+    template <class... A>
+    const char* Format(std::string_view fmt, A&&... args)
+    {
+        if constexpr ((IsFormatArg<A> && ...)) {
+            const FormatArg fargs[] = { FormatArg(args)..., FormatArg() };
+            if (Changed(fargs, sizeof...(A)))
+                text = fmt::vformat(fmt, fmt::make_format_args(args...));
+        }
+        else {
+            //other types can't be compared so they are formatted every time
+            valid = false;
+            text = fmt::vformat(fmt, fmt::make_format_args(args...));
+        }
+        return text.c_str();
+    }
+#else
+    template <class... A>
+    const char* Format(const FormatString& fmt, A&&... args)
+    {
+        const FormatArg fargs[] = { FormatArg(args)..., FormatArg() };
+        if (Changed(fargs, sizeof...(A))) {
+            text.clear();
+            FormatTo(text, fmt, fargs, sizeof...(A));
+        }
+        return text.c_str();
+    }
+#endif
+
+    void Invalidate() { valid = false; }
+
+private:
+    //previous argument kept by value, string arguments are copied
+    struct Arg
+    {
+        FormatArg::Kind kind;
+        unsigned long long bits;
+        std::string s;
+    };
+    static unsigned long long Bits(const FormatArg& a)
+    {
+        unsigned long long bits = 0;
+        switch (a.kind) {
+        case FormatArg::Int: bits = (unsigned long long)a.i; break;
+        case FormatArg::UInt: bits = a.u; break;
+        case FormatArg::Float: memcpy(&bits, &a.f, sizeof(a.f)); break;
+        case FormatArg::Double: memcpy(&bits, &a.d, sizeof(a.d)); break;
+        case FormatArg::Bool: bits = a.b; break;
+        case FormatArg::Char: bits = (unsigned char)a.c; break;
+        default: break;
+        }
+        return bits;
+    }
+    bool Changed(const FormatArg* args, size_t n)
+    {
+        bool changed = !valid || prev.size() != n;
+        prev.resize(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            Arg& p = prev[i];
+            unsigned long long bits = Bits(args[i]);
+            if (!changed && p.kind == args[i].kind && p.bits == bits && 
+                (p.kind != FormatArg::Str || p.s == args[i].s))
+                continue;
+            changed = true;
+            p.kind = args[i].kind;
+            p.bits = bits;
+            if (p.kind == FormatArg::Str)
+                p.s.assign(args[i].s.data(), args[i].s.size());
+        }
+        valid = true;
+        return changed;
+    }
+
+    std::string text;
+    std::vector<Arg> prev;
+    bool valid = false;
+};
+
+}
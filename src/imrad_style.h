@@ -0,0 +1,580 @@
+#pragma once
+#include "imrad.h"
+#include <fstream> //Save/LoadStyle
+#include <iomanip> //std::quoted
+#include <sstream> 
+#include <map>
+#ifndef ANDROID
+#include <filesystem> //font file checks in StyleCacheHeader
+#endif
+
+namespace ImRad {
+
+//For debugging pruposes
+inline void SaveStyle(std::string_view fname_, const ImGuiStyle* src = nullptr, const std::map<std::string, std::string>& extra = {})
+{
+    const ImGuiStyle* style = src ? src : &ImGui::GetStyle();
+    std::string fname(fname_.begin(), fname_.end());
+    std::ofstream fout(fname);
+    if (!fout)
+        throw std::runtime_error("can't write '" + fname + "'");
+    
+    fout << "[colors]\n";
+    for (int i = 0; i < ImGuiCol_COUNT; ++i) {
+        fout << ImGui::GetStyleColorName(i) << " = ";
+        const auto& clr = style->Colors[i];
+        fout << int(clr.x * 255) << " " << int(clr.y * 255) << " " 
+            << int(clr.z * 255) << " " << int(clr.w * 255) << "\n";
+    }
+
+    fout << "\n[variables]\n";
+#define WRITE_FLT(a) fout << #a " = " << style->a << "\n"
+#define WRITE_VEC(a) fout << #a " = " << style->a.x << " " << style->a.y << "\n"
+    
+    WRITE_FLT(Alpha);
+    WRITE_FLT(DisabledAlpha);
+    WRITE_VEC(WindowPadding);
+    WRITE_FLT(WindowRounding);
+    WRITE_FLT(WindowBorderSize);
+    WRITE_VEC(WindowMinSize);
+    WRITE_VEC(WindowTitleAlign);
+    WRITE_FLT(ChildRounding);
+    WRITE_FLT(ChildBorderSize);
+    WRITE_FLT(PopupRounding);
+    WRITE_FLT(PopupBorderSize);
+    WRITE_VEC(FramePadding);
+    WRITE_FLT(FrameRounding);
+    WRITE_FLT(FrameBorderSize);
+    WRITE_VEC(ItemSpacing);
+    WRITE_VEC(ItemInnerSpacing);
+    WRITE_VEC(CellPadding);
+    WRITE_FLT(IndentSpacing);
+    WRITE_FLT(ScrollbarSize);
+    WRITE_FLT(ScrollbarRounding);
+    WRITE_FLT(TabRounding);
+    WRITE_FLT(TabBorderSize);
+#undef WRITE_FLT
+#undef WRITE_VEC
+
+    fout << "\n[fonts]\n";
+    fout << "Default = \"Roboto-Medium.ttf\" size 20\n";
+    
+    std::string lastSection;
+    for (const auto& kv : extra)
+    {
+        size_t i = kv.first.find_last_of('.');
+        if (i == std::string::npos)
+            continue;
+        if (kv.first.substr(0, i) != lastSection) {
+            lastSection = kv.first.substr(0, i);
+            fout << "\n[" << lastSection << "]\n";
+        }
+        fout << kv.first.substr(i + 1) << " = " << kv.second << "\n";
+    }
+}
+
+//This function can be used in your code to load style and fonts from the INI file
+//It is also used by ImRAD when switching themes
+inline void LoadStyle(std::string_view fname, float fontScaling = 1, ImGuiStyle* dst = nullptr, std::map<std::string, ImFont*>* fontMap = nullptr, std::map<std::string, std::string>* extra = nullptr)
+{
+    ImGuiStyle* style = dst ? dst : &ImGui::GetStyle();
+    *style = ImGuiStyle();
+    auto& io = ImGui::GetIO();
+
+    std::string parentPath(fname);
+    size_t ix = parentPath.find_last_of("/\\");
+    if (ix != std::string::npos)
+        parentPath.resize(ix + 1);
+
+    std::ifstream fin(std::string(fname.begin(), fname.end()));
+    if (!fin)
+        throw std::runtime_error("Can't read " + std::string(fname));
+    std::string line;
+    std::string cat;
+    int lastClr = -1;
+    std::string lastFont;
+    while (std::getline(fin, line)) 
+    {
+        if (line.empty() || line[0] == ';' || line[0] == '#')
+            continue;
+        else if (line[0] == '[' && line.back() == ']')
+            cat = line.substr(1, line.size() - 2);
+        else
+        {
+            size_t i1 = line.find_first_not_of("=\t ", 0);
+            size_t i2 = line.find_first_of("=\t ", i1);
+            if (i1 == std::string::npos || i2 == std::string::npos)
+                continue;
+            std::string key = line.substr(i1, i2 - i1);
+            i1 = line.find_first_not_of("=\t ", i2);
+            std::istringstream is(line.substr(i1));
+            
+            if (cat == "colors")
+            {
+                for (int i = lastClr + 1; i != lastClr; i = (i + 1) % ImGuiCol_COUNT)
+                    if (key == ImGui::GetStyleColorName(i)) {
+                        lastClr = i;
+                        int r, g, b, a;
+                        is >> r >> g >> b >> a;
+                        style->Colors[i].x = r / 255.f;
+                        style->Colors[i].y = g / 255.f;
+                        style->Colors[i].z = b / 255.f;
+                        style->Colors[i].w = a / 255.f;
+                        break;
+                    }
+            }
+            else if (cat == "variables")
+            {
+#define READ_FLT(a) if (key == #a) is >> style->a;
+#define READ_VEC(a) if (key == #a) is >> style->a.x >> style->a.y;
+                
+                READ_FLT(Alpha);
+                READ_FLT(DisabledAlpha);
+                READ_VEC(WindowPadding);
+                READ_FLT(WindowRounding);
+                READ_FLT(WindowBorderSize);
+                READ_VEC(WindowMinSize);
+                READ_VEC(WindowTitleAlign);
+                READ_FLT(ChildRounding);
+                READ_FLT(ChildBorderSize);
+                READ_FLT(PopupRounding);
+                READ_FLT(PopupBorderSize);
+                READ_VEC(FramePadding);
+                READ_FLT(FrameRounding);
+                READ_FLT(FrameBorderSize);
+                READ_VEC(ItemSpacing);
+                READ_VEC(ItemInnerSpacing);
+                READ_VEC(CellPadding);
+                READ_FLT(IndentSpacing);
+                READ_FLT(ScrollbarSize);
+                READ_FLT(ScrollbarRounding);
+                READ_FLT(TabRounding);
+                READ_FLT(TabBorderSize);
+#undef READ_FLT
+#undef READ_VEC
+            }
+            else if (cat == "fonts")
+            {
+                std::string fname, path;
+                float size = 20;
+                ImVec2 goffset;
+                bool hasRange = false;
+                static std::vector<std::unique_ptr<ImWchar[]>> rngs;
+
+                is >> std::quoted(fname);
+                path = fname;
+                bool isAbsolute = path.size() >= 2 && (path[0] == '/' || path[1] == ':');
+                if (!isAbsolute)
+                    path = parentPath + path;
+                std::string tmp;
+                while (is >> tmp)
+                {
+                    if (tmp == "size")
+                        is >> size;
+                    else if (tmp == "range") {
+                        hasRange = true;
+                        //needs to outlive this function
+                        rngs.push_back(std::unique_ptr<ImWchar[]>(new ImWchar[3]));
+                        is >> rngs.back()[0] >> rngs.back()[1];
+                        rngs.back()[2] = 0;
+                    }
+                    else if (tmp == "goffset") {
+                        is >> goffset.x >> goffset.y;
+                    }
+                }
+
+                ImFontConfig cfg;
+                strncpy(cfg.Name, key.c_str(), sizeof(cfg.Name));
+                cfg.Name[sizeof(cfg.Name) - 1] = '\0';
+                cfg.MergeMode = key == lastFont;
+                cfg.GlyphRanges = hasRange ? rngs.back().get() : nullptr;
+                cfg.GlyphOffset = { goffset.x * fontScaling, goffset.y * fontScaling };
+#ifdef ANDROID
+                void* font_data;
+                int font_data_size = GetAssetData(fname.c_str(), &font_data);
+                ImFont* fnt = io.Fonts->AddFontFromMemoryTTF(font_data, font_data_size, size * fontScaling);
+#else
+                if (!std::ifstream(path))
+                    throw std::runtime_error("Can't read '" + path + "'");
+                ImFont* fnt = io.Fonts->AddFontFromFileTTF(path.c_str(), size * fontScaling, &cfg);
+#endif
+                if (!fnt)
+                    throw std::runtime_error("Can't load " + path);
+                if (!cfg.MergeMode && fontMap)
+                    (*fontMap)[lastFont == "" ? "" : key] = fnt;
+            
+                lastFont = key;
+            }
+            else if (extra)
+            {
+                (*extra)[cat + "." + key] = is.str();
+            }
+        }
+    }
+    if (fontMap && !(*fontMap).count(""))
+        (*fontMap)[""] = io.Fonts->AddFontDefault();
+    
+    FontTable::Invalidate();
+    FontTable::Rebuild(io.Fonts);
+}
+
+//Binary style cache written by CompileStyle and read by LoadStyleCache
+//It holds the finished ImGuiStyle and the baked font atlas so startup
+//doesn't parse the INI file or rasterize fonts. The cache is tied to the
+//ImGui build, to the INI content and to size and mtime of the font files
+struct StyleCacheHeader
+{
+    char magic[8];
+    int imguiVersion;
+    unsigned styleSize;
+    unsigned glyphSize;
+    float fontScaling;
+    ImU32 iniHash;
+    unsigned iniSize;
+    ImU32 fontsHash;
+};
+
+inline bool ReadStyleFile(std::string_view fname, std::string& data)
+{
+    std::ifstream fin(std::string(fname), std::ios::binary | std::ios::ate);
+    if (!fin)
+        return false;
+    data.resize((size_t)fin.tellg());
+    fin.seekg(0);
+    return (bool)fin.read(data.data(), data.size());
+}
+
+//hashes size and mtime of font files listed in the [fonts] section
+//paths are resolved the same way as in LoadStyle
+inline ImU32 HashStyleFonts(std::string_view iniName, const std::string& ini)
+{
+    std::string parentPath(iniName);
+    size_t ix = parentPath.find_last_of("/\\");
+    if (ix != std::string::npos)
+        parentPath.resize(ix + 1);
+    else
+        parentPath.clear();
+
+    ImU32 hash = 0;
+    std::istringstream fin(ini);
+    std::string line, cat;
+    while (std::getline(fin, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty() || line[0] == ';' || line[0] == '#')
+            continue;
+        if (line[0] == '[' && line.back() == ']') {
+            cat = line.substr(1, line.size() - 2);
+            continue;
+        }
+        if (cat != "fonts")
+            continue;
+        size_t i1 = line.find_first_not_of("=\t ", 0);
+        size_t i2 = line.find_first_of("=\t ", i1);
+        if (i1 == std::string::npos || i2 == std::string::npos)
+            continue;
+        i1 = line.find_first_not_of("=\t ", i2);
+        if (i1 == std::string::npos)
+            continue;
+        std::istringstream is(line.substr(i1));
+        std::string path;
+        is >> std::quoted(path);
+        bool isAbsolute = path.size() >= 2 && (path[0] == '/' || path[1] == ':');
+        if (!isAbsolute)
+            path = parentPath + path;
+        hash = ImHashStr(path.c_str(), 0, hash);
+#ifndef ANDROID
+        std::error_code err;
+        long long size = (long long)std::filesystem::file_size(path, err);
+        if (err)
+            size = -1;
+        auto time = std::filesystem::last_write_time(path, err);
+        long long stamp = err ? 0 : (long long)time.time_since_epoch().count();
+        hash = ImHashData(&size, sizeof(size), hash);
+        hash = ImHashData(&stamp, sizeof(stamp), hash);
+#endif
+    }
+    return hash;
+}
+
+inline StyleCacheHeader MakeStyleCacheHeader(const std::string& ini, float fontScaling)
+{
+    StyleCacheHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, "IMRADSTY", 8);
+    hdr.imguiVersion = IMGUI_VERSION_NUM;
+    hdr.styleSize = sizeof(ImGuiStyle);
+    hdr.glyphSize = sizeof(ImFontGlyph);
+    hdr.fontScaling = fontScaling;
+    hdr.iniHash = ImHashData(ini.data(), ini.size());
+    hdr.iniSize = (unsigned)ini.size();
+    return hdr;
+}
+
+//Compiles the style INI file into a binary cache loadable by LoadStyleCache
+//Fonts are built in a temporary atlas so io.Fonts stays untouched
+inline void CompileStyle(std::string_view iniName, std::string_view cacheName, float fontScaling = 1)
+{
+    std::string ini;
+    if (!ReadStyleFile(iniName, ini))
+        throw std::runtime_error("Can't read " + std::string(iniName));
+
+    auto& io = ImGui::GetIO();
+    ImFontAtlas* prevAtlas = io.Fonts;
+    ImFontAtlas atlas;
+    ImGuiStyle style;
+    std::map<std::string, ImFont*> fontMap;
+    std::map<std::string, std::string> extra;
+    io.Fonts = &atlas;
+    try {
+        LoadStyle(iniName, fontScaling, &style, &fontMap, &extra);
+    }
+    catch (...) {
+        io.Fonts = prevAtlas;
+        FontTable::Remove(&atlas);
+        throw;
+    }
+    io.Fonts = prevAtlas;
+    FontTable::Remove(&atlas);
+    if (!atlas.Build())
+        throw std::runtime_error("Can't build fonts of " + std::string(iniName));
+
+    unsigned char* pixels;
+    int width, height, bpp;
+    if (atlas.TexPixelsAlpha8 && !atlas.TexPixelsUseColors)
+        atlas.GetTexDataAsAlpha8(&pixels, &width, &height, &bpp);
+    else
+        atlas.GetTexDataAsRGBA32(&pixels, &width, &height, &bpp);
+
+    std::string out;
+    auto put = [&](const void* data, size_t size) {
+        out.append((const char*)data, size);
+    };
+    auto putStr = [&](std::string_view str) {
+        unsigned size = (unsigned)str.size();
+        put(&size, sizeof(size));
+        put(str.data(), size);
+    };
+    StyleCacheHeader hdr = MakeStyleCacheHeader(ini, fontScaling);
+    hdr.fontsHash = HashStyleFonts(iniName, ini);
+    put(&hdr, sizeof(hdr));
+    put(&style, sizeof(style));
+    
+    put(&atlas.Flags, sizeof(atlas.Flags));
+    put(&width, sizeof(width));
+    put(&height, sizeof(height));
+    put(&bpp, sizeof(bpp));
+    put(&atlas.TexUvWhitePixel, sizeof(atlas.TexUvWhitePixel));
+    put(atlas.TexUvLines, sizeof(atlas.TexUvLines));
+    put(pixels, (size_t)width * height * bpp);
+
+    int fontCount = atlas.Fonts.Size;
+    put(&fontCount, sizeof(fontCount));
+    for (const ImFont* font : atlas.Fonts)
+    {
+        std::string name = font->ConfigData ? font->ConfigData->Name : "";
+        std::string key = name;
+        for (const auto& f : fontMap)
+            if (f.second == font) {
+                key = f.first;
+                break;
+            }
+        putStr(key);
+        putStr(name);
+        put(&font->FontSize, sizeof(font->FontSize));
+        put(&font->Ascent, sizeof(font->Ascent));
+        put(&font->Descent, sizeof(font->Descent));
+        put(&font->FallbackChar, sizeof(font->FallbackChar));
+        put(&font->EllipsisChar, sizeof(font->EllipsisChar));
+        int glyphCount = font->Glyphs.Size;
+        put(&glyphCount, sizeof(glyphCount));
+        put(font->Glyphs.Data, glyphCount * sizeof(ImFontGlyph));
+    }
+
+    int extraCount = (int)extra.size();
+    put(&extraCount, sizeof(extraCount));
+    for (const auto& ex : extra) {
+        putStr(ex.first);
+        putStr(ex.second);
+    }
+
+    std::ofstream fout(std::string(cacheName), std::ios::binary);
+    if (!fout || !fout.write(out.data(), out.size()))
+        throw std::runtime_error("Can't write " + std::string(cacheName));
+}
+
+//Loads style and fonts compiled by CompileStyle, content of io.Fonts is replaced
+//Falls back to LoadStyle(iniName) when the cache is missing or doesn't match
+//the INI file or its font files. With empty iniName only the ImGui build
+//and fontScaling are checked
+//Returns true when the cache was used
+inline bool LoadStyleCache(std::string_view cacheName, std::string_view iniName, float fontScaling = 1, ImGuiStyle* dst = nullptr, std::map<std::string, ImFont*>* fontMap = nullptr, std::map<std::string, std::string>* extra = nullptr)
+{
+    auto fallback = [&] {
+        if (iniName.empty())
+            throw std::runtime_error("Can't read " + std::string(cacheName));
+        LoadStyle(iniName, fontScaling, dst, fontMap, extra);
+        return false;
+    };
+    
+    std::string data;
+    if (!ReadStyleFile(cacheName, data) || data.size() < sizeof(StyleCacheHeader))
+        return fallback();
+    StyleCacheHeader hdr;
+    memcpy(&hdr, data.data(), sizeof(hdr));
+    if (iniName.empty()) {
+        StyleCacheHeader ref = MakeStyleCacheHeader("", fontScaling);
+        if (memcmp(hdr.magic, ref.magic, sizeof(hdr.magic)) ||
+            hdr.imguiVersion != ref.imguiVersion ||
+            hdr.styleSize != ref.styleSize || hdr.glyphSize != ref.glyphSize ||
+            hdr.fontScaling != ref.fontScaling)
+            return fallback();
+    }
+    else {
+        std::string ini;
+        if (!ReadStyleFile(iniName, ini))
+            throw std::runtime_error("Can't read " + std::string(iniName));
+        StyleCacheHeader ref = MakeStyleCacheHeader(ini, fontScaling);
+        ref.fontsHash = HashStyleFonts(iniName, ini);
+        if (memcmp(&hdr, &ref, sizeof(hdr)))
+            return fallback();
+    }
+
+    //parse everything first so a truncated cache leaves io.Fonts intact
+    size_t pos = sizeof(hdr);
+    auto get = [&](void* ptr, size_t size) {
+        if (data.size() - pos < size)
+            return false;
+        memcpy(ptr, data.data() + pos, size);
+        pos += size;
+        return true;
+    };
+    auto getStr = [&](std::string& str) {
+        unsigned size;
+        if (!get(&size, sizeof(size)) || data.size() - pos < size)
+            return false;
+        str.assign(data.data() + pos, size);
+        pos += size;
+        return true;
+    };
+    struct FontData
+    {
+        std::string key, name;
+        float size, ascent, descent;
+        ImWchar fallbackChar, ellipsisChar;
+        size_t glyphs = 0;
+        int glyphCount = 0;
+    };
+    ImGuiStyle style;
+    ImFontAtlasFlags atlasFlags;
+    int width, height, bpp;
+    ImVec2 uvWhitePixel;
+    ImVec4 uvLines[IM_ARRAYSIZE(ImFontAtlas::TexUvLines)];
+    if (!get(&style, sizeof(style)) ||
+        !get(&atlasFlags, sizeof(atlasFlags)) ||
+        !get(&width, sizeof(width)) ||
+        !get(&height, sizeof(height)) ||
+        !get(&bpp, sizeof(bpp)) ||
+        !get(&uvWhitePixel, sizeof(uvWhitePixel)) ||
+        !get(uvLines, sizeof(uvLines)) ||
+        width <= 0 || height <= 0 || (bpp != 1 && bpp != 4))
+        return fallback();
+    size_t pixelsPos = pos;
+    size_t pixelsSize = (size_t)width * height * bpp;
+    if (data.size() - pos < pixelsSize)
+        return fallback();
+    pos += pixelsSize;
+
+    int fontCount;
+    if (!get(&fontCount, sizeof(fontCount)) || fontCount <= 0)
+        return fallback();
+    std::vector<FontData> fonts(fontCount);
+    for (auto& fd : fonts)
+    {
+        if (!getStr(fd.key) || !getStr(fd.name) ||
+            !get(&fd.size, sizeof(fd.size)) ||
+            !get(&fd.ascent, sizeof(fd.ascent)) ||
+            !get(&fd.descent, sizeof(fd.descent)) ||
+            !get(&fd.fallbackChar, sizeof(fd.fallbackChar)) ||
+            !get(&fd.ellipsisChar, sizeof(fd.ellipsisChar)) ||
+            !get(&fd.glyphCount, sizeof(fd.glyphCount)) ||
+            fd.glyphCount < 0 ||
+            data.size() - pos < fd.glyphCount * sizeof(ImFontGlyph))
+            return fallback();
+        fd.glyphs = pos;
+        pos += fd.glyphCount * sizeof(ImFontGlyph);
+    }
+    std::map<std::string, std::string> extraData;
+    int extraCount;
+    if (!get(&extraCount, sizeof(extraCount)))
+        return fallback();
+    for (int i = 0; i < extraCount; ++i) {
+        std::string key, val;
+        if (!getStr(key) || !getStr(val))
+            return fallback();
+        extraData[key] = val;
+    }
+
+    //fill the atlas as if it was built, the backend uploads it as usual
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    atlas->Clear();
+    FontTable::Invalidate();
+    atlas->Flags = atlasFlags;
+    atlas->TexWidth = width;
+    atlas->TexHeight = height;
+    atlas->TexUvScale = { 1.f / width, 1.f / height };
+    atlas->TexUvWhitePixel = uvWhitePixel;
+    memcpy(atlas->TexUvLines, uvLines, sizeof(uvLines));
+    void* pixels = IM_ALLOC(pixelsSize);
+    memcpy(pixels, data.data() + pixelsPos, pixelsSize);
+    if (bpp == 4) {
+        atlas->TexPixelsRGBA32 = (unsigned int*)pixels;
+        atlas->TexPixelsUseColors = true;
+    }
+    else
+        atlas->TexPixelsAlpha8 = (unsigned char*)pixels;
+
+    //fonts have no TTF data so the atlas must not be rebuilt
+    atlas->ConfigData.reserve(fontCount);
+    for (const auto& fd : fonts)
+    {
+        ImFont* font = IM_NEW(ImFont);
+        atlas->Fonts.push_back(font);
+        font->ContainerAtlas = atlas;
+        font->FontSize = fd.size;
+        font->Ascent = fd.ascent;
+        font->Descent = fd.descent;
+        font->FallbackChar = fd.fallbackChar;
+        font->EllipsisChar = fd.ellipsisChar;
+        font->Glyphs.resize(fd.glyphCount);
+        if (fd.glyphCount)
+            memcpy(font->Glyphs.Data, data.data() + fd.glyphs, fd.glyphCount * sizeof(ImFontGlyph));
+
+        ImFontConfig cfg;
+        strncpy(cfg.Name, fd.name.c_str(), sizeof(cfg.Name));
+        cfg.Name[sizeof(cfg.Name) - 1] = '\0';
+        cfg.FontDataOwnedByAtlas = false;
+        cfg.SizePixels = fd.size;
+        cfg.DstFont = font;
+        atlas->ConfigData.push_back(cfg);
+    }
+    for (int i = 0; i < fontCount; ++i)
+    {
+        ImFont* font = atlas->Fonts[i];
+        font->ConfigData = &atlas->ConfigData[i];
+        font->ConfigDataCount = 1;
+        font->BuildLookupTable();
+        if (fontMap)
+            (*fontMap)[fonts[i].key] = font;
+    }
+    atlas->TexReady = true;
+    FontTable::Rebuild(atlas);
+
+    *(dst ? dst : &ImGui::GetStyle()) = style;
+    if (extra)
+        extra->insert(extraData.begin(), extraData.end());
+    return true;
+}
+
+}
@@ -0,0 +1,260 @@
+#pragma once
+#include "imrad.h"
+#include <string_view>
+
+#ifdef IMRAD_WITH_GLFW
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+#ifdef IMRAD_WITH_STB
+#include <stb_image.h> //for LoadTextureFromFile
+#endif
+#endif
+
+#ifdef IMRAD_WITH_STB
+#include <thread> //for LoadTextureAsync
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <chrono>
+#include <map>
+#endif
+
+namespace ImRad {
+
+#if (defined (IMRAD_WITH_GLFW) || defined(ANDROID)) && defined(IMRAD_WITH_STB)
+//returns RGBA pixels, free with stbi_image_free
+inline unsigned char* LoadImageData(const std::string& filename, int* w, int* h)
+{
+#ifdef ANDROID
+    void* buffer;
+    int len = GetAssetData(filename.c_str(), &buffer);
+    return stbi_load_from_memory((const unsigned char*)buffer, len, w, h, NULL, 4);
+#else
+    return stbi_load(filename.c_str(), w, h, NULL, 4);
+#endif
+}
+
+//uploads RGBA pixels into a new texture, call from the GL thread
+inline Texture CreateTexture(
+    const unsigned char* image_data,
+    int w, int h,
+    int minFilter = GL_LINEAR,
+    int magFilter = GL_LINEAR,
+    int wrapS = GL_CLAMP_TO_EDGE, // This is required on WebGL for non power-of-two textures
+    int wrapT = GL_CLAMP_TO_EDGE // Same
+) {
+    Texture tex;
+    tex.w = w;
+    tex.h = h;
+
+    // Create a OpenGL texture identifier
+    GLuint image_texture;
+    glGenTextures(1, &image_texture);
+    tex.id = (ImTextureID)(intptr_t)image_texture;
+    glBindTexture(GL_TEXTURE_2D, image_texture);
+
+    // Setup filtering parameters for display
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapS); 
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapT); 
+
+    // Upload pixels into texture
+#if defined(GL_UNPACK_ROW_LENGTH) && !defined(__EMSCRIPTEN__)
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, image_data);
+    return tex;
+}
+
+// Simple helper function to load an image into a OpenGL texture with common settings
+// https://github.com/ocornut/imgui/wiki/Image-Loading-and-Displaying-Examples
+inline Texture LoadTextureFromFile(
+    std::string_view filename,
+    int minFilter = GL_LINEAR, 
+    int magFilter = GL_LINEAR, 
+    int wrapS = GL_CLAMP_TO_EDGE, // This is required on WebGL for non power-of-two textures
+    int wrapT = GL_CLAMP_TO_EDGE // Same
+) {
+    // Load from file
+    int w, h;
+    unsigned char* image_data = LoadImageData(std::string(filename), &w, &h);
+    if (image_data == NULL)
+        return {};
+
+    Texture tex = CreateTexture(image_data, w, h, minFilter, magFilter, wrapS, wrapT);
+    stbi_image_free(image_data);
+    return tex;
+}
+
+//Decodes images on worker threads. Decoded images are uploaded from Load calls
+//(which run on the GL thread) but only up to FrameBudgetMs per frame so that 
+//many big images don't block a single frame. Uploads run outside the lock so
+//workers are never blocked by GL. Failed decodes are retried after RetryDelayMs 
+//which doubles with each failure up to MaxRetryDelayMs
+class AsyncTextureLoader
+{
+public:
+    static inline float FrameBudgetMs = 4.f;
+    static inline int MaxWorkers = 4;
+    static inline float RetryDelayMs = 500.f;
+    static inline float MaxRetryDelayMs = 30000.f;
+
+    static AsyncTextureLoader& Get() 
+    {
+        static AsyncTextureLoader loader;
+        return loader;
+    }
+
+    //returns placeholder with id=0 until the texture is uploaded
+    //placeholder w, h contain image size as soon as it is decoded
+    Texture Load(std::string_view filename)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto it = requests.find(filename);
+        if (it == requests.end())
+        {
+            it = requests.emplace(std::string(filename), Request()).first;
+            Enqueue(it->first);
+            return {};
+        }
+        
+        Request& req = it->second;
+        if (req.state == Request::Failed)
+        {
+            if (std::chrono::steady_clock::now() >= req.retryTime)
+            {
+                req.state = Request::Queued;
+                Enqueue(it->first);
+            }
+            return req.tex;
+        }
+        if (req.state != Request::Decoded)
+            return req.tex;
+
+        if (ImGui::GetFrameCount() != frame) {
+            frame = ImGui::GetFrameCount();
+            frameTime = 0;
+        }
+        if (frameTime >= FrameBudgetMs)
+            return req.tex;
+        
+        //take the pixels and upload without holding the lock
+        //requests are never erased so req stays valid
+        unsigned char* data = req.data;
+        Texture tex = req.tex;
+        req.data = nullptr;
+        req.state = Request::Uploading;
+        lock.unlock();
+
+        auto t0 = std::chrono::steady_clock::now();
+        tex = CreateTexture(data, tex.w, tex.h);
+        stbi_image_free(data);
+        frameTime += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        
+        lock.lock();
+        req.tex = tex;
+        req.state = Request::Uploaded;
+        return tex;
+    }
+
+    ~AsyncTextureLoader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        cond.notify_all();
+        for (auto& th : workers)
+            th.join();
+        for (auto& req : requests)
+            if (req.second.data)
+                stbi_image_free(req.second.data);
+    }
+
+private:
+    struct Request
+    {
+        enum { Queued, Decoded, Uploading, Uploaded, Failed };
+        int state = Queued;
+        unsigned char* data = nullptr;
+        Texture tex{};
+        int failures = 0;
+        std::chrono::steady_clock::time_point retryTime;
+    };
+
+    AsyncTextureLoader() = default;
+
+    //call with mutex locked
+    void Enqueue(const std::string& fname)
+    {
+        queue.push_back(fname);
+        if (workers.empty())
+        {
+            int n = std::clamp((int)std::thread::hardware_concurrency() - 1, 1, MaxWorkers);
+            for (int i = 0; i < n; ++i)
+                workers.emplace_back([this] { Work(); });
+        }
+        cond.notify_one();
+    }
+
+    void Work()
+    {
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] { return stop || !queue.empty(); });
+            if (stop)
+                return;
+            std::string fname = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+            
+            int w = 0, h = 0;
+            unsigned char* data = LoadImageData(fname, &w, &h);
+            
+            lock.lock();
+            Request& req = requests[fname];
+            req.data = data;
+            req.tex.w = w;
+            req.tex.h = h;
+            if (data)
+            {
+                req.state = Request::Decoded;
+                req.failures = 0;
+            }
+            else
+            {
+                req.state = Request::Failed;
+                float delay = std::min(RetryDelayMs * (1 << std::min(req.failures, 16)), MaxRetryDelayMs);
+                ++req.failures;
+                req.retryTime = std::chrono::steady_clock::now() + 
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<float, std::milli>(delay));
+            }
+        }
+    }
+
+    std::map<std::string, Request, std::less<>> requests;
+    std::deque<std::string> queue;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool stop = false;
+    int frame = -1;
+    float frameTime = 0;
+};
+
+//non-blocking version of LoadTextureFromFile. Call it every frame until
+//returned texture is valid e.g. if (!tex) tex = LoadTextureAsync(fname);
+inline Texture LoadTextureAsync(std::string_view filename)
+{
+    return AsyncTextureLoader::Get().Load(filename);
+}
+#else
+Texture LoadTextureFromFile(std::string_view filename);
+Texture LoadTextureAsync(std::string_view filename);
+#endif
+
+}
@@ -1,6 +1,7 @@
 #include "node.h"
 #include "stx.h"
 #include "imrad.h"
+#include "imrad_texture.h"
 #include "cppgen.h"
 #include "binding_input.h"
 #include "binding_field.h"
@@ -83,6 +84,89 @@ std::string ParseShortcutOld(const std::string& line)
     return sh;
 }
 
+//widgets repeated by itemCount share one generated member so per-widget 
+//caches like LabelCache or ComboIndex can't be used there
+bool InDataLoop(UINode* node, UIContext& ctx)
+{
+    std::vector<UINode*> chain;
+    if (ctx.parents.size() && ctx.parents.back() == node)
+        chain = ctx.parents; //export
+    else if (ctx.root) {
+        for (UINode* n = node; n; ) {
+            chain.push_back(n);
+            auto parent = ctx.root->FindChild(n);
+            n = parent ? parent->first : nullptr;
+        }
+    }
+    for (UINode* n : chain) {
+        auto* w = dynamic_cast<Widget*>(n);
+        if (w && !w->itemCount.empty())
+            return true;
+    }
+    return false;
+}
+
+//wraps ImRad::FrameFormat label argument into a LabelCache member call
+std::string CachedLabelArg(const std::string& arg, UIContext& ctx)
+{
+    const std::string_view FRAME_FORMAT = "ImRad::FrameFormat(";
+    if (arg.compare(0, FRAME_FORMAT.size(), FRAME_FORMAT))
+        return arg; //nothing to cache
+    std::string name;
+    for (int n = 1; ; ++n) {
+        name = std::string(ctx.codeGen->LABEL_CACHE_NAME) + std::to_string(n);
+        if (ctx.codeGen->CreateNamedVar(name, "ImRad::LabelCache", "", CppGen::Var::Impl))
+            break;
+    }
+    return name + ".Format(" + arg.substr(FRAME_FORMAT.size());
+}
+
+//converts lcN.Format(...) back to ImRad::FrameFormat(...)
+bool ParseCachedLabelArg(std::string& arg, UIContext& ctx)
+{
+    const auto& prefix = ctx.codeGen->LABEL_CACHE_NAME;
+    if (arg.compare(0, prefix.size(), prefix))
+        return false;
+    size_t i = prefix.size();
+    while (i < arg.size() && std::isdigit(arg[i]))
+        ++i;
+    if (i == prefix.size() || arg.compare(i, 8, ".Format("))
+        return false;
+    arg = "ImRad::FrameFormat(" + arg.substr(i + 8);
+    return true;
+}
+
+//GetFontByName("name") is resolved once into a FontHandle member
+//bound font expressions are left as they are
+std::string CachedFontArg(const std::string& arg, UIContext& ctx)
+{
+    const std::string_view GET_FONT = "ImRad::GetFontByName(";
+    if (arg.compare(0, GET_FONT.size(), GET_FONT) || 
+        !cpp::is_cstr(std::string_view(arg).substr(GET_FONT.size(), arg.size() - GET_FONT.size() - 1)))
+        return arg;
+    std::string name;
+    for (int n = 1; ; ++n) {
+        name = std::string(ctx.codeGen->FONT_HANDLE_NAME) + std::to_string(n);
+        if (ctx.codeGen->CreateNamedVar(name, "ImRad::FontHandle", "", CppGen::Var::Impl))
+            break;
+    }
+    return name + ".Get(" + arg.substr(GET_FONT.size());
+}
+
+//converts fhN.Get(...) back to ImRad::GetFontByName(...)
+std::string ParseCachedFontArg(const std::string& arg, UIContext& ctx)
+{
+    const auto& prefix = ctx.codeGen->FONT_HANDLE_NAME;
+    if (arg.compare(0, prefix.size(), prefix))
+        return arg;
+    size_t i = prefix.size();
+    while (i < arg.size() && std::isdigit(arg[i]))
+        ++i;
+    if (i == prefix.size() || arg.compare(i, 5, ".Get("))
+        return arg;
+    return "ImRad::GetFontByName(" + arg.substr(i + 5);
+}
+
 //----------------------------------------------------
 
 void UINode::CloneChildrenFrom(const UINode& node, UIContext& ctx)
@@ -1071,7 +1155,7 @@ void Widget::Export(std::ostream& os, UIContext& ctx)
     }
     if (!style_font.empty())
     {
-        os << ctx.ind << "ImGui::PushFont(" << style_font.to_arg() << ");\n";
+        os << ctx.ind << "ImGui::PushFont(" << CachedFontArg(style_font.to_arg(), ctx) << ");\n";
     }
     if (!style_text.empty())
     {
@@ -1456,7 +1540,7 @@ void Widget::Import(cpp::stmt_iterator& sit, UIContext& ctx)
         else if (sit->kind == cpp::CallExpr && sit->callee == "ImGui::PushFont")
         {
             if (sit->params.size())
-                style_font.set_from_arg(sit->params[0]);
+                style_font.set_from_arg(ParseCachedFontArg(sit->params[0], ctx));
         }
         else if (sit->kind == cpp::CallExpr && sit->callee == "ImGui::PushStyleColor")
         {
@@ -1880,7 +1964,6 @@ void Widget::TreeUI(UIContext& ctx)
     if (GetIcon()) {
         icon = GetIcon();
     }
-    icon += "##" + std::to_string((unsigned long long)this);
     std::string suff;
     if (hasPos)
         suff += "P";
@@ -1905,7 +1988,7 @@ void Widget::TreeUI(UIContext& ctx)
     int flags = ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_OpenOnDoubleClick;
     if (children.empty())
         flags |= ImGuiTreeNodeFlags_Leaf;
-    if (ImGui::TreeNodeEx(icon.c_str(), flags))
+    if (ImGui::TreeNodeEx(this, flags, "%s", icon.c_str()))
     {
         if (ImGui::IsItemClicked())
         {
@@ -1927,7 +2010,6 @@ void Widget::TreeUI(UIContext& ctx)
         if (!itemCount.empty())
         {
             std::string icon = ICON_FA_RETWEET; // SHARE_NODES;
-            icon += "##IC" + std::to_string((unsigned long long)this);
             std::string label = itemCount.index_name_or(ctx.codeGen->FOR_VAR_NAME);
             label += " = 0.." + itemCount.limit.to_arg();
             float sp = ImGui::GetFontSize() * 1.4f - ImGui::CalcTextSize(icon.c_str(), 0, true).x;
@@ -1938,7 +2020,7 @@ void Widget::TreeUI(UIContext& ctx)
             //we keep all items open, OpenOnDoubleClick is to block flickering
             int flags = ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_OpenOnDoubleClick;
             ImGui::SetNextItemOpen(true);
-            if (ImGui::TreeNodeEx(icon.c_str(), flags))
+            if (ImGui::TreeNodeEx(&itemCount, flags, "%s", icon.c_str()))
             {
                 ImGui::PopStyleColor();
                 ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyle().Colors[selected ? ImGuiCol_ButtonHovered : ImGuiCol_TextDisabled]);
@@ -2257,15 +2339,19 @@ void Text::DoExport(std::ostream& os, UIContext& ctx)
     if (alignToFrame)
         os << ctx.ind << "ImGui::AlignTextToFramePadding();\n";
 
+    std::string arg = text.to_arg();
+    if (cachedLabel && !InDataLoop(this, ctx))
+        arg = CachedLabelArg(arg, ctx);
+
     if (wrap)
     {
         os << ctx.ind << "ImGui::PushTextWrapPos(0);\n";
-        os << ctx.ind << "ImGui::TextUnformatted(" << text.to_arg() << ");\n";
+        os << ctx.ind << "ImGui::TextUnformatted(" << arg << ");\n";
         os << ctx.ind << "ImGui::PopTextWrapPos();\n";
     }
     else
     {
-        os << ctx.ind << "ImGui::TextUnformatted(" << text.to_arg() << ");\n";
+        os << ctx.ind << "ImGui::TextUnformatted(" << arg << ");\n";
     }
 }
 
@@ -2282,7 +2368,9 @@ void Text::DoImport(const cpp::stmt_iterator& sit, UIContext& ctx)
     else if (sit->kind == cpp::CallExpr && sit->callee == "ImGui::TextUnformatted")
     {
         if (sit->params.size() >= 1) {
-            text.set_from_arg(sit->params[0]);
+            std::string arg = sit->params[0];
+            cachedLabel = ParseCachedLabelArg(arg, ctx);
+            text.set_from_arg(arg);
             if (text.value() == cpp::INVALID_TEXT)
                 ctx.errors.push_back("Text: unable to parse text");
         }
@@ -2299,6 +2387,7 @@ Text::Properties()
         { "text", &text, true },
         { "alignToFramePadding", &alignToFrame },
         { "text.wrap", &wrap },
+        { "text.cachedLabel", &cachedLabel },
     });
     return props;
 }
@@ -2343,8 +2432,15 @@ bool Text::PropertyUI(int i, UIContext& ctx)
         ImGui::SetNextItemWidth(-ImGui::GetFrameHeight());
         changed = ImGui::Checkbox("##wrap", wrap.access());
         break;
+    case 5:
+        ImGui::BeginDisabled(text.used_variables().empty() || InDataLoop(this, ctx));
+        ImGui::Text("cachedLabel");
+        ImGui::TableNextColumn();
+        changed = InputDirectVal("##cachedLabel", &cachedLabel, ctx);
+        ImGui::EndDisabled();
+        break;
     default:
-        return Widget::PropertyUI(i - 5, ctx);
+        return Widget::PropertyUI(i - 6, ctx);
     }
     return changed;
 }
@@ -2778,6 +2874,9 @@ ImDrawList* Button::DoDraw(UIContext& ctx)
 void Button::DoExport(std::ostream& os, UIContext& ctx)
 {
     bool closePopup = ctx.kind == TopWindow::ModalPopup && modalResult != ImRad::None;
+    std::string arg = label.to_arg();
+    if (cachedLabel && !InDataLoop(this, ctx))
+        arg = CachedLabelArg(arg, ctx);
     os << ctx.ind;
     if (!onChange.empty() || closePopup || dropDownMenu != "")
         os << "if (";
@@ -2788,11 +2887,11 @@ void Button::DoExport(std::ostream& os, UIContext& ctx)
     }
     else if (small)
     {
-        os << "ImGui::SmallButton(" << label.to_arg() << ")";
+        os << "ImGui::SmallButton(" << arg << ")";
     }
     else
     {
-        os << "ImGui::Button(" << label.to_arg() << ", { "
+        os << "ImGui::Button(" << arg << ", { "
             << size_x.to_arg(ctx.unit, ctx.stretchSizeExpr[0]) << ", " 
             << size_y.to_arg(ctx.unit, ctx.stretchSizeExpr[1])
             << " })";
@@ -2832,7 +2931,9 @@ void Button::DoImport(const cpp::stmt_iterator& sit, UIContext& ctx)
         sit->callee == "ImGui::Button")
     {
         ctx.importLevel = sit->level;
-        label.set_from_arg(sit->params[0]);
+        std::string arg = sit->params[0];
+        cachedLabel = ParseCachedLabelArg(arg, ctx);
+        label.set_from_arg(arg);
         
         if (sit->params.size() >= 2) {
             auto size = cpp::parse_size(sit->params[1]);
@@ -2854,7 +2955,9 @@ void Button::DoImport(const cpp::stmt_iterator& sit, UIContext& ctx)
         sit->callee == "ImGui::SmallButton")
     {
         ctx.importLevel = sit->level;
-        label.set_from_arg(sit->params[0]);
+        std::string arg = sit->params[0];
+        cachedLabel = ParseCachedLabelArg(arg, ctx);
+        label.set_from_arg(arg);
     }
     else if ((sit->kind == cpp::CallExpr || sit->kind == cpp::IfCallBlock) &&
         sit->callee == "ImGui::ArrowButton")
@@ -2898,6 +3001,7 @@ Button::Properties()
         { "button.modalResult", &modalResult },
         { "button.dropDownMenu", &dropDownMenu },
         { "button.small", &small },
+        { "button.cachedLabel", &cachedLabel },
         { "size_x", &size_x },
         { "size_y", &size_y },
         });
@@ -3060,6 +3164,13 @@ bool Button::PropertyUI(int i, UIContext& ctx)
         ImGui::EndDisabled();
         break;
     case 15:
+        ImGui::BeginDisabled(arrowDir != ImGuiDir_None || label.used_variables().empty() || InDataLoop(this, ctx));
+        ImGui::Text("cachedLabel");
+        ImGui::TableNextColumn();
+        changed = InputDirectVal("##cachedLabel", &cachedLabel, ctx);
+        ImGui::EndDisabled();
+        break;
+    case 16:
         ImGui::BeginDisabled(small || arrowDir != ImGuiDir_None);
         ImGui::Text("size_x");
         ImGui::TableNextColumn();
@@ -3069,7 +3180,7 @@ bool Button::PropertyUI(int i, UIContext& ctx)
         changed |= BindingButton("size_x", &size_x, ctx);
         ImGui::EndDisabled();
         break;
-    case 16:
+    case 17:
         ImGui::BeginDisabled(small || arrowDir != ImGuiDir_None);
         ImGui::Text("size_y");
         ImGui::TableNextColumn();
@@ -3080,7 +3191,7 @@ bool Button::PropertyUI(int i, UIContext& ctx)
         ImGui::EndDisabled();
         break;
     default:
-        return Widget::PropertyUI(i - 17, ctx);
+        return Widget::PropertyUI(i - 18, ctx);
     }
     return changed;
 }
@@ -4233,7 +4344,20 @@ void Combo::DoExport(std::ostream& os, UIContext& ctx)
         id = std::string("\"##") + fieldName.c_str() + "\"";
     
     os << "ImRad::Combo(" << id << ", &" << fieldName.to_arg() 
-        << ", " << items.to_arg() << ", " << flags.to_arg() << ")";
+        << ", " << items.to_arg() << ", " << flags.to_arg();
+    if (indexed && !InDataLoop(this, ctx))
+    {
+        std::string name;
+        for (int n = 1; ; ++n) {
+            name = std::string(ctx.codeGen->COMBO_INDEX_NAME) + std::to_string(n);
+            if (ctx.codeGen->CreateNamedVar(name, "ImRad::ComboIndex", "", CppGen::Var::Impl))
+                break;
+        }
+        os << ", " << name;
+        if (filter)
+            os << ", true";
+    }
+    os << ")";
 
     if (!onChange.empty()) {
         os << ")\n";
@@ -4278,6 +4402,10 @@ void Combo::DoImport(const cpp::stmt_iterator& sit, UIContext& ctx)
             flags.set_from_arg(sit->params[3]);
         }
 
+        const auto& prefix = ctx.codeGen->COMBO_INDEX_NAME;
+        indexed = sit->params.size() >= 5 && !sit->params[4].compare(0, prefix.size(), prefix);
+        filter = indexed && sit->params.size() >= 6 && sit->params[5] == "true";
+
         if (sit->kind == cpp::IfCallThenCall)
             onChange.set_from_arg(sit->callee2);
     }
@@ -4298,6 +4426,8 @@ Combo::Properties()
         { "label", &label, true },
         { "combo.field_name", &fieldName },
         { "combo.items", &items },
+        { "combo.indexed", &indexed },
+        { "combo.filter", &filter },
         { "size_x", &size_x },
         });
     return props;
@@ -4397,6 +4527,20 @@ bool Combo::PropertyUI(int i, UIContext& ctx)
         changed |= BindingButton("items", &items, ctx);
         break;
     case 10:
+        ImGui::BeginDisabled(InDataLoop(this, ctx));
+        ImGui::Text("indexed");
+        ImGui::TableNextColumn();
+        changed = InputDirectVal("##indexed", &indexed, ctx);
+        ImGui::EndDisabled();
+        break;
+    case 11:
+        ImGui::BeginDisabled(!indexed || InDataLoop(this, ctx));
+        ImGui::Text("filter");
+        ImGui::TableNextColumn();
+        changed = InputDirectVal("##filter", &filter, ctx);
+        ImGui::EndDisabled();
+        break;
+    case 12:
         ImGui::Text("size_x");
         ImGui::TableNextColumn();
         ImGui::SetNextItemWidth(-ImGui::GetFrameHeight());
@@ -4405,7 +4549,7 @@ bool Combo::PropertyUI(int i, UIContext& ctx)
         changed |= BindingButton("size_x", &size_x, ctx);
         break;
     default:
-        return Widget::PropertyUI(i - 11, ctx);
+        return Widget::PropertyUI(i - 13, ctx);
     }
     return changed;
 }
@@ -5200,6 +5344,58 @@ bool ColorEdit::EventUI(int i, UIContext& ctx)
 
 //----------------------------------------------------
 
+//Image textures are shared by all Image widgets and their clones
+//entries are keyed by canonical path and mtime so a changed file gets a new texture
+//GL texture is released when the last user goes away
+static std::map<std::pair<std::string, fs::file_time_type>, std::weak_ptr<ImRad::Texture>> textureCache;
+static int textureCheck = 0;
+
+static std::shared_ptr<ImRad::Texture> LoadSharedTexture(const std::string& fname)
+{
+    std::error_code err;
+    std::string path = fs::weakly_canonical(fname, err).string();
+    if (err)
+        path = fname;
+    auto time = fs::last_write_time(path, err);
+    if (err)
+        return {};
+    auto key = std::make_pair(path, time);
+    
+    auto it = textureCache.find(key);
+    if (it != textureCache.end()) 
+    {
+        if (auto tex = it->second.lock())
+            return tex;
+    }
+    
+    ImRad::Texture tmp = ImRad::LoadTextureFromFile(path);
+    if (!tmp)
+        return {};
+    std::shared_ptr<ImRad::Texture> tex(new ImRad::Texture(tmp), [](ImRad::Texture* t) {
+        GLuint id = (GLuint)(intptr_t)t->id;
+        glDeleteTextures(1, &id);
+        delete t;
+        });
+    Image::ReleaseTextures();
+    textureCache[key] = tex;
+    return tex;
+}
+
+void Image::CheckTextureFiles()
+{
+    ++textureCheck;
+}
+
+void Image::ReleaseTextures()
+{
+    for (auto i = textureCache.begin(); i != textureCache.end(); ) {
+        if (i->second.expired())
+            i = textureCache.erase(i);
+        else
+            ++i;
+    }
+}
+
 Image::Image(UIContext& ctx)
 {
     if (ctx.createVars)
@@ -5217,22 +5413,30 @@ std::unique_ptr<Widget> Image::Clone(UIContext& ctx)
 
 ImDrawList* Image::DoDraw(UIContext& ctx)
 {
+    if (texCheck != textureCheck)
+    {
+        //reloads only when the file's mtime changed
+        texCheck = textureCheck;
+        if (tex)
+            RefreshTexture(ctx);
+    }
+
     float w = 20, h = 20;
     if (!size_x.zero())
         w = size_x.eval_px(ImGuiAxis_X, ctx);
-    else if (tex.id)
-        w = (float)tex.w;
+    else if (tex)
+        w = (float)tex->w;
     if (!size_y.zero())
         h = size_y.eval_px(ImGuiAxis_Y, ctx);
-    else if (tex.id)
-        h = (float)tex.h;
+    else if (tex)
+        h = (float)tex->h;
 
     ImVec2 uv0(0, 0);
     ImVec2 uv1(1, 1);
-    if (stretchPolicy != Scale && tex.id)
+    if (stretchPolicy != Scale && tex)
     {
-        float wrel = w / tex.w;
-        float hrel = h / tex.h;
+        float wrel = w / tex->w;
+        float hrel = h / tex->h;
         float scale = 1.f;
         if (stretchPolicy == FitIn)
             scale = std::min(wrel, hrel);
@@ -5243,7 +5447,7 @@ ImDrawList* Image::DoDraw(UIContext& ctx)
         uv0 = { -(wrel - 1) / 2, -(hrel - 1) / 2 };
         uv1 = { 1 + (wrel - 1) / 2, 1 + (hrel - 1) / 2 };
     }
-    ImGui::Image(tex.id, { w, h }, uv0, uv1);
+    ImGui::Image(tex ? tex->id : 0, { w, h }, uv0, uv1);
     return ImGui::GetWindowDrawList();
 }
 
@@ -5256,7 +5460,9 @@ void Image::DoExport(std::ostream& os, UIContext& ctx)
 
     os << ctx.ind << "if (!" << fieldName.to_arg() << ")\n";
     ctx.ind_up();
-    os << ctx.ind << fieldName.to_arg() << " = ImRad::LoadTextureFromFile(" << fileName.to_arg() << ");\n";
+    os << ctx.ind << fieldName.to_arg() << " = ImRad::" 
+        << (asyncLoad ? "LoadTextureAsync(" : "LoadTextureFromFile(") 
+        << fileName.to_arg() << ");\n";
     ctx.ind_down();
 
     os << ctx.ind << "ImGui::Image(" << fieldName.to_arg() << ".id, { ";
@@ -5276,11 +5482,11 @@ void Image::DoExport(std::ostream& os, UIContext& ctx)
 
     ImVec2 uv0(0, 0);
     ImVec2 uv1(1, 1);
-    if (stretchPolicy != Scale && tex.id && size_x.has_value() && size_y.has_value())
+    if (stretchPolicy != Scale && tex && size_x.has_value() && size_y.has_value())
     {
         //todo: binded dimensions
-        float wrel = size_x.zero() ? 1.f : size_x.eval_px(ImGuiAxis_X, ctx) / tex.w;
-        float hrel = size_y.zero() ? 1.f : size_y.eval_px(ImGuiAxis_Y, ctx) / tex.h;
+        float wrel = size_x.zero() ? 1.f : size_x.eval_px(ImGuiAxis_X, ctx) / tex->w;
+        float hrel = size_y.zero() ? 1.f : size_y.eval_px(ImGuiAxis_Y, ctx) / tex->h;
         float scale = 1.f;
         if (stretchPolicy == FitIn)
             scale = std::min(wrel, hrel);
@@ -5307,6 +5513,11 @@ void Image::DoImport(const cpp::stmt_iterator& sit, UIContext& ctx)
         auto i = sit->line.find("ImRad::LoadTextureFromFile(");
         if (i != std::string::npos)
             fileName.set_from_arg(sit->line.substr(i + 27, sit->line.size() - 1 - i - 27));
+        i = sit->line.find("ImRad::LoadTextureAsync(");
+        if (i != std::string::npos) {
+            asyncLoad = true;
+            fileName.set_from_arg(sit->line.substr(i + 24, sit->line.size() - 1 - i - 24));
+        }
     }
     else if (sit->kind == cpp::CallExpr && sit->callee == "ImGui::Image")
     {
@@ -5356,6 +5567,7 @@ Image::Properties()
         { "image.field_name", &fieldName },
         { "size_x", &size_x },
         { "size_y", &size_y },
+        { "image.async_load", &asyncLoad },
         });
     return props;
 }
@@ -5417,8 +5629,13 @@ bool Image::PropertyUI(int i, UIContext& ctx)
         ImGui::SameLine(0, 0);
         changed |= BindingButton("size_y", &size_y, ctx);
         break;
+    case 5:
+        ImGui::Text("asyncLoad");
+        ImGui::TableNextColumn();
+        changed = ImGui::Checkbox("##asyncLoad", asyncLoad.access());
+        break;
     default:
-        return Widget::PropertyUI(i - 5, ctx);
+        return Widget::PropertyUI(i - 6, ctx);
     }
     return changed;
 }
@@ -5438,8 +5655,11 @@ bool Image::PickFileName(UIContext& ctx)
 
 void Image::RefreshTexture(UIContext& ctx)
 {
-    tex.id = 0;
+    tex.reset();
     
+    //headless runs like --roundtrip have no GL context to upload to
+    if (!glfwGetCurrentContext())
+        return;
     if (fileName.empty() ||
         !fileName.used_variables().empty())
         return;
@@ -5457,7 +5677,7 @@ void Image::RefreshTexture(UIContext& ctx)
         fname = (fs::path(ctx.workingDir) / fileName.value()).string();
     }
 
-    tex = ImRad::LoadTextureFromFile(fname);
+    tex = LoadSharedTexture(fname);
     if (!tex) 
     {
         if (!ctx.importState) {
@@ -5492,8 +5712,7 @@ ImDrawList* CustomWidget::DoDraw(UIContext& ctx)
     if (!size.y)
         size.y = 20;
 
-    std::string id = std::to_string((uintptr_t)this);
-    ImGui::BeginChild(id.c_str(), size, ImGuiChildFlags_Border);
+    ImGui::BeginChild(ImGui::GetID(this), size, ImGuiChildFlags_Border);
     ImGui::EndChild();
 
     ImDrawList* dl = ImGui::GetWindowDrawList();
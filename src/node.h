@@ -12,6 +12,9 @@
 
 extern const color32 FIELD_REF_CLR;
 
+std::string CachedFontArg(const std::string& arg, UIContext& ctx);
+std::string ParseCachedFontArg(const std::string& arg, UIContext& ctx);
+
 #define DRAW_STR(a) cpp::to_draw_str(a.value()).c_str()
 
 
@@ -171,6 +174,7 @@ struct Text : Widget
     bindable<std::string> text = "text";
     direct_val<bool> alignToFrame = false;
     direct_val<bool> wrap = false;
+    direct_val<bool> cachedLabel = false;
     
     Text(UIContext& ctx);
     auto Clone(UIContext& ctx)->std::unique_ptr<Widget>;
@@ -218,6 +222,7 @@ struct Button : Widget
     direct_val<ImRad::ModalResult> modalResult = ImRad::None;
     direct_val<shortcut_> shortcut = "";
     direct_val<std::string> dropDownMenu = "";
+    direct_val<bool> cachedLabel = false;
     event<> onChange;
 
     Button(UIContext& ctx);
@@ -308,6 +313,8 @@ struct Combo : Widget
     field_ref<std::string> fieldName;
     bindable<std::vector<std::string>> items;
     flags_helper flags = ImGuiComboFlags_None;
+    direct_val<bool> indexed = false;
+    direct_val<bool> filter = false;
     event<> onChange;
 
     Combo(UIContext& ctx);
@@ -390,8 +397,10 @@ struct Image : Widget
     field_ref<ImRad::Texture> fieldName;
     enum StretchPolicy { None, Scale, FitIn, FitOut };
     direct_val<StretchPolicy> stretchPolicy = Scale;
+    direct_val<bool> asyncLoad = false;
     
-    ImRad::Texture tex;
+    std::shared_ptr<ImRad::Texture> tex;
+    int texCheck = 0;
 
     Image(UIContext& ctx);
     auto Clone(UIContext& ctx)->std::unique_ptr<Widget>;
@@ -404,6 +413,11 @@ struct Image : Widget
     bool PickFileName(UIContext& ctx);
     int Behavior() { return Widget::Behavior() | HasSizeX | HasSizeY; }
     const char* GetIcon() const { return ICON_FA_IMAGE; }
+
+    //image files may have changed, textures are checked on next draw
+    static void CheckTextureFiles();
+    //forgets shared textures no longer used e.g. after closing a document
+    static void ReleaseTextures();
 };
 
 struct CustomWidget : Widget
@@ -35,7 +35,8 @@ void TreeNodeProp(const char* name, const std::string& label, F&& f)
     ImGui::Indent();
 }
 
-bool DataLoopProp(const char* name, data_loop* val, UIContext& ctx)
+//virtualize: -1 - not supported, 0 - disabled, 1 - enabled
+bool DataLoopProp(const char* name, data_loop* val, UIContext& ctx, int virtualize = -1)
 {
     bool changed = false;
     ImVec2 pad = ImGui::GetStyle().FramePadding;
@@ -63,6 +64,18 @@ bool DataLoopProp(const char* name, data_loop* val, UIContext& ctx)
         ImGui::SetNextItemWidth(-ImGui::GetFrameHeight());
         changed |= InputFieldRef("##index", &val->index, true, ctx);
         ImGui::EndDisabled();
+        if (virtualize >= 0)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, FIELD_REF_CLR);
+            ImGui::AlignTextToFramePadding();
+            ImGui::BeginDisabled(val->empty() || !virtualize);
+            ImGui::Text("virtualized");
+            ImGui::TableNextColumn();
+            changed |= InputDirectVal("##virtualized", &val->virtualized, ctx);
+            ImGui::EndDisabled();
+        }
         ImGui::TreePop();
     }
     else
@@ -72,6 +85,19 @@ bool DataLoopProp(const char* name, data_loop* val, UIContext& ctx)
     return changed;
 }
 
+const int VIRTUALIZED_PREVIEW_ROWS = 3;
+
+//marks virtualized data loop in the bottom right corner of the last item
+void DrawVirtualizedMark()
+{
+    ImDrawList* dl = ImGui::GetWindowDrawList();
+    ImVec2 p = ImGui::GetItemRectMax();
+    const char* mark = ICON_FA_ELLIPSIS_VERTICAL;
+    ImVec2 sz = ImGui::CalcTextSize(mark);
+    ImVec2 pad = ImGui::GetStyle().FramePadding;
+    dl->AddText({ p.x - sz.x - pad.x, p.y - sz.y - pad.y }, ImGui::GetColorU32(ImGuiCol_TextDisabled), mark);
+}
+
 //----------------------------------------------------------------------------
 
 TopWindow::TopWindow(UIContext& ctx)
@@ -342,8 +368,12 @@ void TopWindow::Export(std::ostream& os, UIContext& ctx)
     ctx.errors.clear();
     ctx.unit = ctx.unit == "px" ? "" : ctx.unit;
     
-    ctx.codeGen->RemovePrefixedVars(std::string(ctx.codeGen->HBOX_NAME));
-    ctx.codeGen->RemovePrefixedVars(std::string(ctx.codeGen->VBOX_NAME));
+    ctx.codeGen->RemovePrefixedVars(std::string(ctx.codeGen->HBOX_NAME), "ImRad::HBox");
+    ctx.codeGen->RemovePrefixedVars(std::string(ctx.codeGen->VBOX_NAME), "ImRad::VBox");
+    ctx.codeGen->RemovePrefixedVars(std::string(ctx.codeGen->LABEL_CACHE_NAME), "ImRad::LabelCache");
+    ctx.codeGen->RemovePrefixedVars(std::string(ctx.codeGen->ROW_HEIGHTS_NAME), "ImRad::RowHeights");
+    ctx.codeGen->RemovePrefixedVars(std::string(ctx.codeGen->COMBO_INDEX_NAME), "ImRad::ComboIndex");
+    ctx.codeGen->RemovePrefixedVars(std::string(ctx.codeGen->FONT_HANDLE_NAME), "ImRad::FontHandle");
 
     //todo: put before ///@ params
     if (userCodeBefore != "")
@@ -382,10 +412,17 @@ void TopWindow::Export(std::ostream& os, UIContext& ctx)
         os << ctx.ind << "return;\n";
         ctx.ind_down();
     }
+    else if (kind == Window)
+    {
+        os << ctx.ind << "if (!isOpen)\n";
+        ctx.ind_up();
+        os << ctx.ind << "return;\n";
+        ctx.ind_down();
+    }
 
     if (!style_font.empty())
     {
-        os << ctx.ind << "ImGui::PushFont(" << style_font.to_arg() << ");\n";
+        os << ctx.ind << "ImGui::PushFont(" << CachedFontArg(style_font.to_arg(), ctx) << ");\n";
     }
     if (!style_bg.empty())
     {
@@ -549,7 +586,7 @@ void TopWindow::Export(std::ostream& os, UIContext& ctx)
             os << ctx.ind << "ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, " <<
                 style_titlePadding.to_arg(ctx.unit) << ");\n";
         }
-        os << ctx.ind << "if (isOpen && ImGui::Begin(" << tit << ", &isOpen, " << flags.to_arg() << "))\n";
+        os << ctx.ind << "if (ImGui::Begin(" << tit << ", &isOpen, " << flags.to_arg() << "))\n";
         os << ctx.ind << "{\n";
         ctx.ind_up();
         if (style_titlePadding.has_value())
@@ -751,9 +788,10 @@ void TopWindow::Export(std::ostream& os, UIContext& ctx)
     }
     else
     {
-        os << ctx.ind << "ImGui::End();\n";
+        //End is required even when Begin returned false (collapsed/clipped)
         ctx.ind_down();
         os << ctx.ind << "}\n";
+        os << ctx.ind << "ImGui::End();\n";
     }
 
     if (style_titlePadding.has_value() && (kind == Window || kind == ModalPopup))
@@ -871,7 +909,7 @@ void TopWindow::Import(cpp::stmt_iterator& sit, UIContext& ctx)
         else if (sit->kind == cpp::CallExpr && sit->callee == "ImGui::PushFont")
         {
             if (sit->params.size())
-                style_font.set_from_arg(sit->params[0]);
+                style_font.set_from_arg(ParseCachedFontArg(sit->params[0], ctx));
         }
         else if (sit->kind == cpp::CallExpr && sit->callee == "ImGui::PushStyleColor")
         {
@@ -994,6 +1032,18 @@ void TopWindow::Import(cpp::stmt_iterator& sit, UIContext& ctx)
             if (sit->params.size() >= 3)
                 flags.set_from_arg(sit->params[2]);
         }
+        else if (sit->kind == cpp::IfCallBlock && sit->callee == "ImGui::Begin" &&
+            sit->params.size() >= 2 && sit->params[1] == "&isOpen")
+        {
+            ctx.kind = kind = Window;
+            title.set_from_arg(sit->params[0]);
+            size_t i = title.access()->rfind("###");
+            if (i != std::string::npos)
+                title.access()->resize(i);
+
+            if (sit->params.size() >= 3)
+                flags.set_from_arg(sit->params[2]);
+        }
         else if (sit->kind == cpp::IfCallBlock && sit->callee == "ImGui::Begin")
         {
             ctx.importLevel = sit->level;
@@ -1419,8 +1469,8 @@ ImDrawList* Table::DoDraw(UIContext& ctx)
     int fl = flags;
     if (stx::count(ctx.selected, this)) //force columns at design time
         fl |= ImGuiTableFlags_BordersInner;
-    std::string name = "table" + std::to_string((uint64_t)this);
-    if (ImGui::BeginTable(name.c_str(), n, fl, size))
+    //pointer based ID, no need to format a name each frame
+    if (ImGui::BeginTableEx("table", ImGui::GetID(this), n, fl, size))
     {
         //need to override drawList because when table is in a Child mode its drawList will be drawn on top
         drawList = ImGui::GetWindowDrawList();
@@ -1437,6 +1487,8 @@ ImDrawList* Table::DoDraw(UIContext& ctx)
             child->Draw(ctx);
         
         int n = itemCount.limit.value();
+        if (itemCount.virtualized)
+            n = std::min(n, VIRTUALIZED_PREVIEW_ROWS);
         for (int r = ImGui::TableGetRowIndex() + 1; r < header + n; ++r)
             ImGui::TableNextRow(0, rh);
 
@@ -1453,6 +1505,8 @@ ImDrawList* Table::DoDraw(UIContext& ctx)
         }
 
         ImGui::EndTable();
+        if (!itemCount.empty() && itemCount.virtualized)
+            DrawVirtualizedMark();
     }
 
     if (!style_childBg.empty())
@@ -1554,7 +1608,7 @@ bool Table::PropertyUI(int i, UIContext& ctx)
         changed = ImGui::Checkbox("##header", header.access());
         break;
     case 8:
-        changed = DataLoopProp("rowCount", &itemCount, ctx);
+        changed = DataLoopProp("rowCount", &itemCount, ctx, rowFilter.empty());
         break;
     case 9:
         ImGui::Text("rowHeight");
@@ -1565,7 +1619,7 @@ bool Table::PropertyUI(int i, UIContext& ctx)
         changed |= BindingButton("rowHeight", &rowHeight, ctx);
         break;
     case 10:
-        ImGui::BeginDisabled(itemCount.empty());
+        ImGui::BeginDisabled(itemCount.empty() || itemCount.virtualized);
         ImGui::Text("rowFilter");
         ImGui::TableNextColumn();
         ImGui::SetNextItemWidth(-ImGui::GetFrameHeight());
@@ -1699,7 +1753,20 @@ void Table::DoExport(std::ostream& os, UIContext& ctx)
 
     if (!itemCount.empty())
     {
-        os << "\n" << ctx.ind << itemCount.to_arg(ctx.codeGen->FOR_VAR_NAME) << "\n" << ctx.ind << "{\n";
+        std::string rh;
+        if (itemCount.virtualized && (rowHeight.empty() || rowHeight.zero()) &&
+            !itemCount.limit.used_variables().empty())
+        {
+            //variable row heights get measured
+            for (int n = ctx.varCounter; ; ++n) {
+                rh = std::string(ctx.codeGen->ROW_HEIGHTS_NAME) + std::to_string(n);
+                if (ctx.codeGen->CreateNamedVar(rh, "ImRad::RowHeights", "", CppGen::Var::Impl))
+                    break;
+            }
+        }
+        else if (!rowHeight.empty())
+            rh = rowHeight.to_arg(ctx.unit);
+        os << "\n" << ctx.ind << itemCount.to_arg(ctx.codeGen->FOR_VAR_NAME, rh) << "\n" << ctx.ind << "{\n";
         ctx.ind_up();
 
         if (!rowFilter.empty())
@@ -1959,6 +2026,8 @@ ImDrawList* Child::DoDraw(UIContext& ctx)
         ImGui::PopStyleVar();
     
     ImGui::EndChild();
+    if (!itemCount.empty() && itemCount.virtualized)
+        DrawVirtualizedMark();
 
     if (!style_outer_padding) 
         ImRad::PopIgnoreWindowPadding(data);
@@ -2004,14 +2073,16 @@ void Child::DoExport(std::ostream& os, UIContext& ctx)
     if (!style_bg.empty())
         os << ctx.ind << "ImGui::PushStyleColor(ImGuiCol_ChildBg, " << style_bg.to_arg() << ");\n";
     
-    os << ctx.ind << "ImGui::BeginChild(\"child" << ctx.varCounter << "\", ";
+    //BeginChild returns false when the child is clipped or collapsed so
+    //the body including user code can be skipped
+    os << ctx.ind << "if (ImGui::BeginChild(\"child" << ctx.varCounter << "\", ";
     if (szvar != "")
         os << szvar << ", ";
     else {
         os << "{ " << size_x.to_arg(ctx.unit, ctx.stretchSizeExpr[0]) << ", "
             << size_y.to_arg(ctx.unit, ctx.stretchSizeExpr[1]) << " }, ";
     }
-    os << flags.to_arg() << ", " << wflags.to_arg() << ");\n";
+    os << flags.to_arg() << ", " << wflags.to_arg() << "))\n";
 
     os << ctx.ind << "{\n";
     ctx.ind_up();
@@ -2061,9 +2132,9 @@ void Child::DoExport(std::ostream& os, UIContext& ctx)
         os << ctx.ind << "/// @separator\n";
     }
 
-    os << ctx.ind << "ImGui::EndChild();\n";
     ctx.ind_down();
     os << ctx.ind << "}\n";
+    os << ctx.ind << "ImGui::EndChild();\n";
 
     if (!style_bg.empty())
         os << ctx.ind << "ImGui::PopStyleColor();\n";
@@ -2108,7 +2179,8 @@ void Child::DoImport(const cpp::stmt_iterator& sit, UIContext& ctx)
             size_y.set_from_arg(size.second);
         }
     }
-    else if (sit->kind == cpp::CallExpr && sit->callee == "ImGui::BeginChild")
+    else if ((sit->kind == cpp::CallExpr || sit->kind == cpp::IfCallBlock) && 
+        sit->callee == "ImGui::BeginChild")
     {
         if (sit->params.size() >= 2) {
             auto size = cpp::parse_size(sit->params[1]);
@@ -2267,7 +2339,7 @@ bool Child::PropertyUI(int i, UIContext& ctx)
         changed = InputDirectVal("##columnBorder", &columnBorder, ctx);
         break;
     case 11:
-        changed = DataLoopProp("itemCount", &itemCount, ctx);
+        changed = DataLoopProp("itemCount", &itemCount, ctx, columnCount.has_value() && columnCount.value() < 2);
         break;
     case 12:
         ImGui::Text("scrollWhenDragging");
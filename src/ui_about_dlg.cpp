@@ -66,8 +66,8 @@ void AboutDlg::Draw()
 
         /// @begin Text
         ImGui::SameLine(0, 2 * ImGui::GetStyle().ItemSpacing.x);
-        ImGui::PushFont(ImRad::GetFontByName("imrad.H1"));
-        ImGui::TextUnformatted(ImRad::Format("{}", VER_STR).c_str());
+        ImGui::PushFont(fh1.Get("imrad.H1"));
+        ImGui::TextUnformatted(ImRad::FrameFormat(IMRAD_FORMAT("{}"), VER_STR));
         ImGui::PopFont();
         /// @end Text
 
@@ -85,7 +85,7 @@ void AboutDlg::Draw()
 
         /// @begin Text
         ImRad::Spacing(2);
-        ImGui::TextUnformatted(ImRad::Format("built with ImGui {}", IMGUI_VERSION).c_str());
+        ImGui::TextUnformatted(ImRad::FrameFormat(IMRAD_FORMAT("built with ImGui {}"), IMGUI_VERSION));
         /// @end Text
 
         /// @begin Text
@@ -6,6 +6,8 @@
 #include <functional>
 #include <imgui.h>
 #include "imrad.h"
+#include "imrad_format.h"
+#include "imrad_texture.h"
 
 class AboutDlg
 {
@@ -27,6 +29,7 @@ private:
     ImRad::ModalResult modalResult;
     std::function<void(ImRad::ModalResult)> callback;
     ImRad::Texture value1;
+    ImRad::FontHandle fh1;
     /// @end impl
 };
 
@@ -51,7 +51,7 @@ void BindingDlg::Draw()
 
         /// @begin Text
         ImGui::PushStyleColor(ImGuiCol_Text, 0xff4d4dff);
-        ImGui::TextUnformatted(ImRad::Format(" {}=", name).c_str());
+        ImGui::TextUnformatted(ImRad::FrameFormat(IMRAD_FORMAT(" {}="), name));
         ImGui::PopStyleColor();
         /// @end Text
 
@@ -59,7 +59,7 @@ void BindingDlg::Draw()
         ImGui::SameLine(0, 1 * ImGui::GetStyle().ItemSpacing.x);
         ImGui::BeginDisabled(true);
         ImGui::PushStyleVar(ImGuiStyleVar_SelectableTextAlign, { 1.f, 0 });
-        ImRad::Selectable(ImRad::Format("{}", type).c_str(), false, ImGuiSelectableFlags_DontClosePopups, { 0, 0 });
+        ImRad::Selectable(ImRad::FrameFormat(IMRAD_FORMAT("{}"), type), false, ImGuiSelectableFlags_DontClosePopups, { 0, 0 });
         ImGui::PopStyleVar();
         ImGui::EndDisabled();
         /// @end Selectable
@@ -120,7 +120,7 @@ void BindingDlg::Draw()
 
                 /// @begin Selectable
                 ImGui::PushStyleVar(ImGuiStyleVar_SelectableTextAlign, { 0, 0 });
-                if (ImRad::Selectable(ImRad::Format("{}", vars[i].first).c_str(), false, ImGuiSelectableFlags_DontClosePopups | ImGuiSelectableFlags_SpanAllColumns, { 0, 0 }))
+                if (ImRad::Selectable(ImRad::FrameFormat(IMRAD_FORMAT("{}"), vars[i].first), false, ImGuiSelectableFlags_DontClosePopups | ImGuiSelectableFlags_SpanAllColumns, { 0, 0 }))
                     OnVarClicked();
                 ImGui::PopStyleVar();
                 /// @end Selectable
@@ -129,7 +129,7 @@ void BindingDlg::Draw()
                 ImRad::TableNextColumn(1);
                 ImGui::BeginDisabled(true);
                 ImGui::PushStyleVar(ImGuiStyleVar_SelectableTextAlign, { 0, 0 });
-                ImRad::Selectable(ImRad::Format("{}", vars[i].second).c_str(), false, ImGuiSelectableFlags_DontClosePopups, { 0, 0 });
+                ImRad::Selectable(ImRad::FrameFormat(IMRAD_FORMAT("{}"), vars[i].second), false, ImGuiSelectableFlags_DontClosePopups, { 0, 0 });
                 ImGui::PopStyleVar();
                 ImGui::EndDisabled();
                 /// @end Selectable
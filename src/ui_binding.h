@@ -6,6 +6,7 @@
 #include <functional>
 #include <imgui.h>
 #include "imrad.h"
+#include "imrad_format.h"
 #include "cppgen.h"
 
 class BindingDlg
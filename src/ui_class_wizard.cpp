@@ -50,11 +50,12 @@ void ClassWizard::Refresh()
         return false;
         });
 
-    used.clear();
-    FindUsed(root, used);
+    //edits in the dialog can rename or remove symbols so rebuild the index
+    symbols.clear();
+    FindUsed(root);
 }
 
-void ClassWizard::FindUsed(UINode* node, std::vector<std::string>& used)
+void ClassWizard::FindUsed(UINode* node)
 {
     for (int i = 0; i < 2; ++i)
     {
@@ -65,12 +66,23 @@ void ClassWizard::FindUsed(UINode* node, std::vector<std::string>& used)
             auto vars = p.property->used_variables();
             for (const auto& var : vars) {
                 assert(var.find_first_of("[.") == std::string::npos);
-                used.push_back(var);
+                symbols.add_ref(var, p.property);
             }
         }
     }
     for (const auto& child : node->children)
-        FindUsed(child.get(), used);
+        FindUsed(child.get());
+}
+
+void ClassWizard::RenameUsed(const std::string& oldn, const std::string& newn)
+{
+    //only properties which reference oldn are touched
+    //the index itself is rebuilt by Refresh
+    const auto* refs = symbols.refs(oldn);
+    if (!refs)
+        return;
+    for (auto* prop : *refs)
+        prop->rename_variable(oldn, newn);
 }
 
 void ClassWizard::Draw()
@@ -152,167 +164,168 @@ void ClassWizard::Draw()
         /// @begin Child
         ImGui::Spacing();
         ImGui::Spacing();
-        ImGui::BeginChild("child2551", { 0, -45 }, ImGuiChildFlags_Border | ImGuiChildFlags_NavFlattened, 0);
-        float autoSizeW = (ImGui::GetContentRegionAvail().x - 150) / 1;
-        ImGui::Columns(2, "", false);
-        ImGui::SetColumnWidth(0, autoSizeW);
-        ImGui::SetColumnWidth(1, BWIDTH + ImGui::GetStyle().ItemSpacing.x);
+        if (ImGui::BeginChild("child2551", { 0, -45 }, ImGuiChildFlags_Border | ImGuiChildFlags_NavFlattened, 0))
+        {
+            float autoSizeW = (ImGui::GetContentRegionAvail().x - 150) / 1;
+            ImGui::Columns(2, "", false);
+            ImGui::SetColumnWidth(0, autoSizeW);
+            ImGui::SetColumnWidth(1, BWIDTH + ImGui::GetStyle().ItemSpacing.x);
 
-        /// @begin Text
-        ImGui::Text("Fields:");
-        /// @end Text
+            /// @begin Text
+            ImGui::Text("Fields:");
+            /// @end Text
 
-        /// @begin Table
-        if (ImGui::BeginTable("table", 4, ImGuiTableFlags_BordersInner | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_SizingStretchProp /*| ImGuiTableFlags_RowBg*/, { 0, -1 }))
-        {
-            ImGui::TableSetupColumn("Section", ImGuiTableColumnFlags_WidthFixed, 20);
-            ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch, 1);
-            ImGui::TableSetupColumn("Type", ImGuiTableColumnFlags_WidthStretch, 1);
-            ImGui::TableSetupColumn("Init", ImGuiTableColumnFlags_WidthStretch, 1);
-            ImGui::TableHeadersRow();
-        
-            for (int i = 0; i < fields.size(); ++i)
+            /// @begin Table
+            if (ImGui::BeginTable("table", 4, ImGuiTableFlags_BordersInner | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_SizingStretchProp /*| ImGuiTableFlags_RowBg*/, { 0, -1 }))
             {
-                ImGui::TableNextRow();
-                ImGui::TableSetColumnIndex(0);
-                ImGui::PushID(i);
-                /// @separator
+                ImGui::TableSetupColumn("Section", ImGuiTableColumnFlags_WidthFixed, 20);
+                ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch, 1);
+                ImGui::TableSetupColumn("Type", ImGuiTableColumnFlags_WidthStretch, 1);
+                ImGui::TableSetupColumn("Init", ImGuiTableColumnFlags_WidthStretch, 1);
+                ImGui::TableHeadersRow();
+        
+                for (int i = 0; i < fields.size(); ++i)
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::PushID(i);
+                    /// @separator
 
-                const auto& var = fields[i];
+                    const auto& var = fields[i];
                 
-                //ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, IM_COL32(255, 255, 255, 255));
-                //ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg1, IM_COL32(192, 192, 192, 255));
+                    //ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, IM_COL32(255, 255, 255, 255));
+                    //ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg1, IM_COL32(192, 192, 192, 255));
                 
-                bool unused = !stx::count(used, var.name);
-                if (unused)
-                    ImGui::PushStyleColor(ImGuiCol_Text, 0xff400040);
+                    bool unused = !symbols.used(var.name);
+                    if (unused)
+                        ImGui::PushStyleColor(ImGuiCol_Text, 0xff400040);
                 
-                const char* icon =
-                    (var.flags & CppGen::Var::Impl) ? ICON_FA_LOCK :
-                    (var.flags & CppGen::Var::Interface) ? ICON_FA_CUBE :
-                    "";
-                const char* tooltip =
-                    (var.flags & CppGen::Var::Impl) ? "private" :
-                    (var.flags & CppGen::Var::Interface) ? "public" :
-                    "uknown";
-                /// @begin Selectable
-                if (ImGui::Selectable(icon, selRow == i, ImGuiSelectableFlags_SpanAllColumns))
-                    selRow = i;
-                if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left) && ImGui::IsItemHovered())
-                    doRenameField = true;
-                //if (ImGui::IsItemHovered() && ImGui::GetMousePos().x < 20)
-                //    ImGui::SetTooltip(tooltip);
-                /// @end Selectable
+                    const char* icon =
+                        (var.flags & CppGen::Var::Impl) ? ICON_FA_LOCK :
+                        (var.flags & CppGen::Var::Interface) ? ICON_FA_CUBE :
+                        "";
+                    const char* tooltip =
+                        (var.flags & CppGen::Var::Impl) ? "private" :
+                        (var.flags & CppGen::Var::Interface) ? "public" :
+                        "uknown";
+                    /// @begin Selectable
+                    if (ImGui::Selectable(icon, selRow == i, ImGuiSelectableFlags_SpanAllColumns))
+                        selRow = i;
+                    if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left) && ImGui::IsItemHovered())
+                        doRenameField = true;
+                    //if (ImGui::IsItemHovered() && ImGui::GetMousePos().x < 20)
+                    //    ImGui::SetTooltip(tooltip);
+                    /// @end Selectable
 
-                /// @begin Selectable
-                ImGui::TableNextColumn();
-                ImGui::Selectable(var.name.c_str(), selRow == i);
-                /// @end Selectable
+                    /// @begin Selectable
+                    ImGui::TableNextColumn();
+                    ImGui::Selectable(var.name.c_str(), selRow == i);
+                    /// @end Selectable
 
-                /// @begin Selectable
-                ImGui::TableNextColumn();
-                ImGui::Selectable(var.type.c_str(), selRow == i);
-                /// @end Selectable
+                    /// @begin Selectable
+                    ImGui::TableNextColumn();
+                    ImGui::Selectable(var.type.c_str(), selRow == i);
+                    /// @end Selectable
 
-                /// @begin Selectable
-                ImGui::TableNextColumn();
-                ImGui::Selectable(var.init.c_str(), selRow == i);
-                /// @end Selectable
+                    /// @begin Selectable
+                    ImGui::TableNextColumn();
+                    ImGui::Selectable(var.init.c_str(), selRow == i);
+                    /// @end Selectable
 
-                if (unused)
-                    ImGui::PopStyleColor();
+                    if (unused)
+                        ImGui::PopStyleColor();
                 
-                /// @separator
-                ImGui::PopID();
-            }
-
-            ImGui::EndTable();
-        }
-        /// @end Table
-
-        /// @begin Button
-        ImGui::NextColumn();
-        if (ImGui::Button("Add Field...", { BWIDTH, 0 }))
-        {
-            newFieldPopup.codeGen = codeGen;
-            newFieldPopup.mode = NewFieldPopup::NewField;
-            newFieldPopup.scope = stypeIdx ? stypes[stypeIdx] : "";
-            newFieldPopup.varType = "";
-            newFieldPopup.OpenPopup([this] {
-                *modified = true;
-                Refresh();
-                });
-        }
-        /// @end Button
+                    /// @separator
+                    ImGui::PopID();
+                }
 
-        /// @begin Button
-        ImGui::Spacing();
-        ImGui::Spacing();
-        ImGui::BeginDisabled(selRow < 0 || selRow >= (int)fields.size());
-        if (ImGui::Button("Rename Field...", { BWIDTH, 0 }) ||
-            (!ImRad::IsItemDisabled() && doRenameField))
-        {
-            newFieldPopup.codeGen = codeGen;
-            newFieldPopup.mode = NewFieldPopup::RenameField;
-            newFieldPopup.scope = stypeIdx ? stypes[stypeIdx] : "";
-            newFieldPopup.varOldName = fields[selRow].name;
-            newFieldPopup.OpenPopup([this] {
-                *modified = true;
-                root->RenameFieldVars(newFieldPopup.varOldName, newFieldPopup.varName);
-                Refresh();
-                });
-        }
-        ImGui::EndDisabled();
-        /// @end Button
+                ImGui::EndTable();
+            }
+            /// @end Table
 
-        /// @begin Button
-        ImGui::Spacing();
-        ImGui::Spacing();
-        ImGui::BeginDisabled(selRow < 0 || selRow >= (int)fields.size());
-        if (ImGui::Button("Remove Field", { BWIDTH, 0 }))
-        {
-            std::string name = fields[selRow].name;
-            if (!stypeIdx && stx::count(used, name)) 
+            /// @begin Button
+            ImGui::NextColumn();
+            if (ImGui::Button("Add Field...", { BWIDTH, 0 }))
             {
-                messageBox.title = "Remove variable";
-                messageBox.message = "Remove used variable '" + name + "' ?";
-                messageBox.buttons = ImRad::Yes | ImRad::No;
-                messageBox.OpenPopup([this,name](ImRad::ModalResult mr) {
-                    if (mr == ImRad::Yes) {
-                        *modified = true;
-                        codeGen->RemoveVar(name);
-                        Refresh();
-                    }
+                newFieldPopup.codeGen = codeGen;
+                newFieldPopup.mode = NewFieldPopup::NewField;
+                newFieldPopup.scope = stypeIdx ? stypes[stypeIdx] : "";
+                newFieldPopup.varType = "";
+                newFieldPopup.OpenPopup([this] {
+                    *modified = true;
+                    Refresh();
                     });
             }
-            else 
+            /// @end Button
+
+            /// @begin Button
+            ImGui::Spacing();
+            ImGui::Spacing();
+            ImGui::BeginDisabled(selRow < 0 || selRow >= (int)fields.size());
+            if (ImGui::Button("Rename Field...", { BWIDTH, 0 }) ||
+                (!ImRad::IsItemDisabled() && doRenameField))
             {
-                *modified = true;
-                codeGen->RemoveVar(name, stypeIdx ? stypes[stypeIdx] : "");
-                Refresh();
+                newFieldPopup.codeGen = codeGen;
+                newFieldPopup.mode = NewFieldPopup::RenameField;
+                newFieldPopup.scope = stypeIdx ? stypes[stypeIdx] : "";
+                newFieldPopup.varOldName = fields[selRow].name;
+                newFieldPopup.OpenPopup([this] {
+                    *modified = true;
+                    RenameUsed(newFieldPopup.varOldName, newFieldPopup.varName);
+                    Refresh();
+                    });
             }
-        }
-        ImGui::EndDisabled();
-        /// @end Button
+            ImGui::EndDisabled();
+            /// @end Button
 
-        /// @begin Button
-        ImGui::Spacing();
-        ImGui::Spacing();
-        ImGui::BeginDisabled(stypeIdx);
-        if (ImGui::Button("Remove Unused", { BWIDTH, 0 }))
-        {
-            for (const auto& fi : fields)
+            /// @begin Button
+            ImGui::Spacing();
+            ImGui::Spacing();
+            ImGui::BeginDisabled(selRow < 0 || selRow >= (int)fields.size());
+            if (ImGui::Button("Remove Field", { BWIDTH, 0 }))
             {
-                if (!stx::count(used, fi.name)) {
+                std::string name = fields[selRow].name;
+                if (!stypeIdx && symbols.used(name)) 
+                {
+                    messageBox.title = "Remove variable";
+                    messageBox.message = "Remove used variable '" + name + "' ?";
+                    messageBox.buttons = ImRad::Yes | ImRad::No;
+                    messageBox.OpenPopup([this,name](ImRad::ModalResult mr) {
+                        if (mr == ImRad::Yes) {
+                            *modified = true;
+                            codeGen->RemoveVar(name);
+                            Refresh();
+                        }
+                        });
+                }
+                else 
+                {
                     *modified = true;
-                    codeGen->RemoveVar(fi.name);
+                    codeGen->RemoveVar(name, stypeIdx ? stypes[stypeIdx] : "");
+                    Refresh();
                 }
             }
-            Refresh();
-        }
-        ImGui::EndDisabled();
-        /// @end Button
+            ImGui::EndDisabled();
+            /// @end Button
 
+            /// @begin Button
+            ImGui::Spacing();
+            ImGui::Spacing();
+            ImGui::BeginDisabled(stypeIdx);
+            if (ImGui::Button("Remove Unused", { BWIDTH, 0 }))
+            {
+                for (const auto& fi : fields)
+                {
+                    if (!symbols.used(fi.name)) {
+                        *modified = true;
+                        codeGen->RemoveVar(fi.name);
+                    }
+                }
+                Refresh();
+            }
+            ImGui::EndDisabled();
+            /// @end Button
+        }
         ImGui::EndChild();
         /// @end Child
 
@@ -333,6 +346,11 @@ void ClassWizard::Draw()
         ImGui::End();
         /// @end TopWindow
     }
+    else if (!symbols.empty())
+    {
+        //the table belongs to the document we were opened for
+        symbols.clear();
+    }
     ImGui::PopStyleVar();
     ImGui::PopStyleVar();
 }
\ No newline at end of file
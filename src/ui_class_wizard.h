@@ -22,13 +22,14 @@ public:
     
 private:
     void Refresh();
-    void FindUsed(UINode* node, std::vector<std::string>& used);
+    void FindUsed(UINode* node);
+    void RenameUsed(const std::string& oldn, const std::string& newn);
 
     std::string varName;
     std::string className;
     std::vector<std::string> stypes;
     std::vector<CppGen::Var> fields;
-    std::vector<std::string> used;
+    symbol_table symbols;
     size_t stypeIdx;
     int selRow;
     
@@ -161,7 +161,7 @@ void HorizLayout::Draw()
         ImRad::Spacing(2);
         ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyle().Colors[ImGuiCol_TextDisabled]);
         ImGui::PushTextWrapPos(0);
-        ImGui::TextUnformatted(ImRad::Format("{} items will be aligned", selected.size()).c_str());
+        ImGui::TextUnformatted(ImRad::FrameFormat(IMRAD_FORMAT("{} items will be aligned"), selected.size()));
         ImGui::PopTextWrapPos();
         ImGui::PopStyleColor();
         /// @end Text
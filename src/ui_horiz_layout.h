@@ -3,6 +3,7 @@
 
 #pragma once
 #include "imrad.h"
+#include "imrad_format.h"
 #include "node.h"
 
 class HorizLayout
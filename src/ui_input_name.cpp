@@ -39,7 +39,7 @@ void InputName::Draw()
     ID = ImGui::GetID("###InputName");
     ImGui::SetNextWindowSize({ 250, 120 }, ImGuiCond_FirstUseEver); //{ 250, 120 }
     bool tmpOpen = true;
-    if (ImGui::BeginPopupModal(ImRad::Format("{}###InputName", title).c_str(), &tmpOpen, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse))
+    if (ImGui::BeginPopupModal(ImRad::FrameFormat(IMRAD_FORMAT("{}###InputName"), title), &tmpOpen, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse))
     {
         if (ioUserData->activeActivity != "")
             ImRad::RenderDimmedBackground(ioUserData->WorkRect(), ioUserData->dimBgRatio);
@@ -60,7 +60,7 @@ void InputName::Draw()
         if (ImGui::IsWindowAppearing())
             ImGui::SetKeyboardFocusHere();
         ImGui::SetNextItemWidth(-1);
-        ImGui::InputTextWithHint("##name", ImRad::Format("{}", hint).c_str(), &name, ImGuiInputTextFlags_CharsNoBlank);
+        ImGui::InputTextWithHint("##name", ImRad::FrameFormat(IMRAD_FORMAT("{}"), hint), &name, ImGuiInputTextFlags_CharsNoBlank);
         if (ImGui::IsItemActive())
             ioUserData->imeType = ImRad::ImeText;
         /// @end Input
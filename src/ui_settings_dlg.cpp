@@ -77,7 +77,7 @@ void SettingsDlg::Draw()
 
         /// @begin Text
         ImGui::SameLine(0, 1 * ImGui::GetStyle().ItemSpacing.x);
-        ImGui::PushFont(ImRad::GetFontByName("imrad.H3"));
+        ImGui::PushFont(fh1.Get("imrad.H3"));
         ImGui::TextUnformatted("Environment Settings");
         vb1.UpdateSize(0, ImRad::VBox::ItemSize);
         ImGui::PopFont();
@@ -110,7 +110,7 @@ void SettingsDlg::Draw()
         /// @begin Child
         ImGui::SameLine(0, 1 * ImGui::GetStyle().ItemSpacing.x);
         ImGui::PushStyleColor(ImGuiCol_ChildBg, 0xffd0d0d0);
-        ImGui::BeginChild("child2", { -1, vb1.GetSize(true) }, ImGuiChildFlags_AlwaysUseWindowPadding | ImGuiChildFlags_NavFlattened, ImGuiWindowFlags_NoSavedSettings);
+        if (ImGui::BeginChild("child2", { -1, vb1.GetSize(true) }, ImGuiChildFlags_AlwaysUseWindowPadding | ImGuiChildFlags_NavFlattened, ImGuiWindowFlags_NoSavedSettings))
         {
             /// @separator
 
@@ -142,8 +142,8 @@ void SettingsDlg::Draw()
             /// @end Combo
 
             /// @separator
-            ImGui::EndChild();
         }
+        ImGui::EndChild();
         ImGui::PopStyleColor();
         vb1.UpdateSize(0, ImRad::VBox::Stretch(1));
         /// @end Child
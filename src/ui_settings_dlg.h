@@ -27,6 +27,7 @@ private:
     std::function<void(ImRad::ModalResult)> callback;
     ImRad::VBox vb1;
     ImRad::HBox hb3;
+    ImRad::FontHandle fh1;
     /// @end impl
 };
 
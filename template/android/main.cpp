@@ -1,4 +1,5 @@
 #include "imrad.h"
+#include "imrad_style.h" //for ImRad::LoadStyle
 #include "imgui/imgui.h"
 #include "imgui/backends/imgui_impl_android.h"
 #include "imgui/backends/imgui_impl_opengl3.h"
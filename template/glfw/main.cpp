@@ -1,4 +1,5 @@
 #include "imrad.h"
+#include "imrad_style.h" //for ImRad::LoadStyle
 #include <imgui.h>
 //#include <IconsFontAwesome6.h>
 #include <backends/imgui_impl_glfw.h>